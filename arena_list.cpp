@@ -0,0 +1,109 @@
+//=================================================================
+// CS 271 - Project 6
+// arena_list.cpp
+// Fall 2025
+// This is the implementation file for the ArenaList class
+//=================================================================
+
+#include <cstring>
+#include <utility>
+
+
+//=================================================================
+// Move constructor
+// Takes over another list's items, leaving it empty
+// Parameters:  other - the list to move from
+// Returns:     none
+//=================================================================
+template <class T>
+ArenaList<T>::ArenaList ( ArenaList&& other ) noexcept : items(other.items), count(other.count), room(other.room)
+{
+    other.items = nullptr;
+    other.count = 0;
+    other.room = 0;
+}
+
+//=================================================================
+// Move assignment
+// Swaps items with another list; the owner releases the old ones
+// Parameters:  other - the list to move from
+// Returns:     this list
+//=================================================================
+template <class T>
+ArenaList<T>& ArenaList<T>::operator= ( ArenaList&& other ) noexcept
+{
+    swap(items, other.items);
+    swap(count, other.count);
+    swap(room, other.room);
+    return *this;
+}
+
+//=================================================================
+// reserve
+// Makes room for n items, moving the list if it has to grow
+// Parameters:  n - number of items
+//              storage - resource the list allocates from
+// Returns:     none
+//=================================================================
+template <class T>
+void ArenaList<T>::reserve ( uint32_t n, pmr::memory_resource* storage )
+{
+    if (n <= room)
+        return;
+    T* grown = static_cast<T*>(storage->allocate(size_t(n) * sizeof(T), alignof(T)));
+    if (count > 0)
+        memcpy(grown, items, size_t(count) * sizeof(T));
+    if (items != nullptr)
+        storage->deallocate(items, size_t(room) * sizeof(T), alignof(T));
+    items = grown;
+    room = n;
+}
+
+//=================================================================
+// push_back
+// Appends an item. A full list doubles its room; an empty one starts
+//   with room for 4, about the degree of a road intersection.
+// Parameters:  item - the item
+//              storage - resource the list allocates from
+// Returns:     none
+//=================================================================
+template <class T>
+void ArenaList<T>::push_back ( const T& item, pmr::memory_resource* storage )
+{
+    if (count == room)
+        reserve(room == 0 ? 4 : 2 * room, storage);
+    items[count++] = item;
+}
+
+//=================================================================
+// assign
+// Replaces the items with a copy of a range
+// Parameters:  first, last - the range
+//              storage - resource the list allocates from
+// Returns:     none
+//=================================================================
+template <class T>
+void ArenaList<T>::assign ( const_iterator first, const_iterator last, pmr::memory_resource* storage )
+{
+    count = 0;
+    reserve(last - first, storage);
+    if (last != first)
+        memcpy(items, first, size_t(last - first) * sizeof(T));
+    count = last - first;
+}
+
+//=================================================================
+// release
+// Frees the items, leaving the list empty
+// Parameters:  storage - resource the list allocated from
+// Returns:     none
+//=================================================================
+template <class T>
+void ArenaList<T>::release ( pmr::memory_resource* storage )
+{
+    if (items != nullptr)
+        storage->deallocate(items, size_t(room) * sizeof(T), alignof(T));
+    items = nullptr;
+    count = 0;
+    room = 0;
+}
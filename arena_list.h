@@ -0,0 +1,56 @@
+//=================================================================
+// CS 271 - Project 6
+// arena_list.h
+// Fall 2025
+// This is the declaration file for the ArenaList class, a growable
+// array whose memory comes from its owner's memory resource
+//=================================================================
+
+#ifndef ARENA_LIST_H
+#define ARENA_LIST_H
+
+#include <cstdint>
+#include <memory_resource>
+#include <type_traits>
+using namespace std;
+
+// Like a vector of a trivially copyable T, except that the memory
+// resource is passed to each call that allocates instead of being
+// stored, which keeps the list at 16 bytes. The list never frees its
+// memory by itself: the owner either calls release with the same
+// resource or destroys the resource, which frees every list at once.
+// Moving leaves the source empty; there is no copy.
+template <class T>
+class ArenaList
+{
+   static_assert(is_trivially_copyable<T>::value, "ArenaList holds trivially copyable types");
+private:
+   T*         items;
+   uint32_t   count;
+   uint32_t   room;     // capacity
+public:
+   typedef T*       iterator;
+   typedef const T* const_iterator;
+
+               ArenaList   ( ) : items(nullptr), count(0), room(0) { }
+               ArenaList   ( ArenaList&& other ) noexcept;
+   ArenaList&  operator=   ( ArenaList&& other ) noexcept;
+               ArenaList   ( const ArenaList& ) = delete;
+   ArenaList&  operator=   ( const ArenaList& ) = delete;
+
+   uint32_t    size        ( ) const { return count; }
+   bool        empty       ( ) const { return count == 0; }
+   iterator    begin       ( ) { return items; }
+   iterator    end         ( ) { return items + count; }
+   const_iterator begin    ( ) const { return items; }
+   const_iterator end      ( ) const { return items + count; }
+   T&          operator[]  ( uint32_t i ) { return items[i]; }
+   const T&    operator[]  ( uint32_t i ) const { return items[i]; }
+
+   void        reserve     ( uint32_t n, pmr::memory_resource* storage );
+   void        push_back   ( const T& item, pmr::memory_resource* storage );
+   void        assign      ( const_iterator first, const_iterator last, pmr::memory_resource* storage );
+   void        release     ( pmr::memory_resource* storage );
+};
+#include "arena_list.cpp"
+#endif
@@ -0,0 +1,49 @@
+//=================================================================
+// CS 271 - Project 6
+// bit_matrix.cpp
+// Fall 2025
+// This is the implementation file for the BitMatrix class
+//=================================================================
+
+
+//=================================================================
+// Default constructor
+// Creates a 0 x 0 matrix
+// Parameters:  none
+// Returns:     none
+//=================================================================
+inline BitMatrix::BitMatrix ( )
+{
+    numRows = 0;
+    numCols = 0;
+    stride = 0;
+}
+
+//=================================================================
+// Constructor
+// Creates a matrix with every cell clear
+// Parameters:  rows - number of rows
+//              cols - number of columns
+// Returns:     none
+//=================================================================
+inline BitMatrix::BitMatrix ( uint32_t rows, uint32_t cols )
+{
+    numRows = rows;
+    numCols = cols;
+    stride = (cols + 63) / 64;
+    words.assign(size_t(rows) * stride, 0);
+}
+
+//=================================================================
+// count
+// Number of set cells
+// Parameters:  none
+// Returns:     the count
+//=================================================================
+inline size_t BitMatrix::count ( ) const
+{
+    size_t total = 0;
+    for (uint64_t word : words)
+        total += __builtin_popcountll(word);
+    return total;
+}
@@ -0,0 +1,39 @@
+//=================================================================
+// CS 271 - Project 6
+// bit_matrix.h
+// Fall 2025
+// This is the declaration file for the BitMatrix class, a matrix of
+// booleans stored one bit per cell
+//=================================================================
+
+#ifndef BIT_MATRIX_H
+#define BIT_MATRIX_H
+
+#include <vector>
+#include <cstdint>
+using namespace std;
+
+// Each row starts on a 64-bit word: cell (r, c) is bit c % 64 of
+// word c / 64 of row r, and bits past cols() are always 0.
+class BitMatrix
+{
+private:
+   vector<uint64_t>  words;
+   uint32_t          numRows;
+   uint32_t          numCols;
+   uint32_t          stride;    // words per row
+public:
+                     BitMatrix   ( );
+                     BitMatrix   ( uint32_t rows, uint32_t cols );
+
+   uint32_t          rows        ( ) const { return numRows; }
+   uint32_t          cols        ( ) const { return numCols; }
+   uint32_t          wordsPerRow ( ) const { return stride; }
+   bool              get         ( uint32_t r, uint32_t c ) const { return words[size_t(r) * stride + (c >> 6)] >> (c & 63) & 1; }
+   void              set         ( uint32_t r, uint32_t c ) { words[size_t(r) * stride + (c >> 6)] |= 1ull << (c & 63); }
+   uint64_t*         row         ( uint32_t r )       { return words.data() + size_t(r) * stride; }
+   const uint64_t*   row         ( uint32_t r ) const { return words.data() + size_t(r) * stride; }
+   size_t            count       ( ) const;
+};
+#include "bit_matrix.cpp"
+#endif
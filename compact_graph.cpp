@@ -0,0 +1,907 @@
+//=================================================================
+// CS 271 - Project 6
+// compact_graph.cpp
+// Fall 2025
+// This is the implementation file for the CompactGraph class
+//=================================================================
+
+#include <climits>
+#include <algorithm>
+#include <sstream>
+#include <fstream>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+
+//=================================================================
+// Default constructor
+// Creates an empty snapshot
+// Parameters:  none
+// Returns:     none
+//=================================================================
+template <class K, class D>
+CompactGraph<K,D>::CompactGraph ( )
+{
+    offsets.adopt(vector<uint32_t>(1, 0));
+    rOffsets.adopt(vector<uint32_t>(1, 0));
+    labelStarts.adopt(vector<uint64_t>(1, 0));
+    scale = 0;
+}
+
+//=================================================================
+// Constructor
+// Builds a CSR snapshot of a graph. Vertices are numbered as order
+//   says (see VertexOrder), the out-edges of each vertex keep their
+//   adjacency list order and every distinct edge label is stored once.
+// Parameters:  g - the graph to snapshot
+//              order - vertex numbering, the graph's own by default
+// Returns:     none
+//=================================================================
+template <class K, class D>
+CompactGraph<K,D>::CompactGraph ( const Graph<K,D>& g, VertexOrder order )
+{
+    uint32_t n = g.vertices.size();
+    // old[i] is the graph index of vertex i, rank the other way around
+    vector<uint32_t> old = vertexOrder(g, order);
+    vector<uint32_t> rank(n);
+    for (uint32_t i = 0; i < n; i++)
+        rank[old[i]] = i;
+
+    vector<K> keyList;
+    vector<double> xy;
+    keyList.reserve(n);
+    xy.reserve(2 * n);
+    for (uint32_t u : old) {
+        keyList.push_back(g.vertices[u].key);
+        xy.push_back(get<0>(g.vertices[u].data));
+        xy.push_back(get<1>(g.vertices[u].data));
+    }
+    if (order == VertexOrder::Insertion) {
+        index = g.index;
+        spatial = atomic_load(&g.spatial);
+    } else {
+        index.reserve(n);
+        for (uint32_t i = 0; i < n; i++)
+            index.insert(keyList[i], i);
+    }
+    keys.adopt(move(keyList));
+    coords.adopt(move(xy));
+
+    // count out-degrees, then prefix sum them into offsets
+    vector<uint32_t> out(n + 1, 0);
+    for (uint32_t i = 0; i < n; i++) {
+        out[i + 1] = out[i] + g.vertices[old[i]].adj.size();
+    }
+
+    uint32_t m = out[n];
+    vector<uint32_t> to(m);
+    vector<double> w(m);
+    vector<uint32_t> ids(m);
+    uint32_t e = 0;
+    for (uint32_t u : old) {
+        for (const auto& edge : g.vertices[u].adj) {
+            to[e] = rank[edge.target];
+            w[e] = edge.weight;
+            ids[e] = edge.label;
+            e++;
+        }
+    }
+
+    // the label table keeps the graph's label ids
+    vector<uint64_t> starts(1, 0);
+    vector<char> chars;
+    for (uint32_t id = 0; id < g.labels.size(); id++) {
+        const string& label = g.labels.text(id);
+        chars.insert(chars.end(), label.begin(), label.end());
+        starts.push_back(chars.size());
+    }
+
+    // reverse CSR by counting sort on the target; in-edges of a vertex
+    // stay in order of their source index
+    vector<uint32_t> in(n + 1, 0);
+    for (uint32_t f = 0; f < m; f++)
+        in[to[f] + 1]++;
+    for (uint32_t v = 0; v < n; v++)
+        in[v + 1] += in[v];
+    vector<uint32_t> sources(m);
+    vector<uint32_t> forward(m);
+    vector<uint32_t> fill(in.begin(), in.end() - 1);
+    for (uint32_t u = 0; u < n; u++) {
+        for (uint32_t f = out[u]; f < out[u + 1]; f++) {
+            uint32_t slot = fill[to[f]]++;
+            sources[slot] = u;
+            forward[slot] = f;
+        }
+    }
+
+    offsets.adopt(move(out));
+    targets.adopt(move(to));
+    weights.adopt(move(w));
+    labelIds.adopt(move(ids));
+    labelStarts.adopt(move(starts));
+    labelChars.adopt(move(chars));
+    rOffsets.adopt(move(in));
+    rSources.adopt(move(sources));
+    rEdges.adopt(move(forward));
+
+    // A* scale: the smallest weight per meter of straight-line length,
+    // shaved a little so rounding can never make the estimate too large
+    double ratio = SearchContext::INF;
+    for (uint32_t u = 0; u < n; u++) {
+        for (uint32_t f = offsets[u]; f < offsets[u + 1]; f++) {
+            double length = haversineDistance(vertexData(u), vertexData(targets[f]));
+            if (length > 0)
+                ratio = min(ratio, max(0.0, weights[f] / length * (1 - 1e-9)));
+        }
+    }
+    scale = ratio == SearchContext::INF ? 0 : ratio;
+}
+
+//=================================================================
+// fileLayout
+// Where each array of a saved graph starts
+// Parameters:  header - counts of the saved graph
+//              bytes - set to the size of each array
+// Returns:     byte offsets of the 12 arrays in file order, followed
+//              by the total file size
+//=================================================================
+template <class K, class D>
+vector<uint64_t> CompactGraph<K,D>::fileLayout ( const FileHeader& header, vector<uint64_t>& bytes )
+{
+    uint64_t n = header.numVertices;
+    uint64_t m = header.numEdges;
+    bytes = {
+        n * sizeof(K),
+        header.indexCapacity * sizeof(typename KeyIndex<K>::Slot),
+        2 * n * sizeof(double),
+        (n + 1) * sizeof(uint32_t),
+        m * sizeof(uint32_t),
+        m * sizeof(double),
+        m * sizeof(uint32_t),
+        (header.numLabels + uint64_t(1)) * sizeof(uint64_t),
+        header.labelBytes,
+        (n + 1) * sizeof(uint32_t),
+        m * sizeof(uint32_t),
+        m * sizeof(uint32_t)
+    };
+    vector<uint64_t> layout;
+    uint64_t at = sizeof(FileHeader);
+    for (uint64_t size : bytes) {
+        at = (at + 15) / 16 * 16;
+        layout.push_back(at);
+        at += size;
+    }
+    layout.push_back(at);
+    return layout;
+}
+
+//=================================================================
+// save
+// Writes the snapshot in a binary format that open() can use in
+//   place, without parsing
+// Parameters:  filename - path of the file to write
+// Returns:     none
+// Throws:      runtime_error if the file cannot be written
+//=================================================================
+template <class K, class D>
+void CompactGraph<K,D>::save ( const string& filename ) const
+{
+    static_assert(is_trivially_copyable<K>::value, "only fixed-size keys can be saved");
+    FileHeader header = {};
+    memcpy(header.magic, "CSRGRAPH", 8);
+    header.version = FILE_VERSION;
+    header.keyBytes = sizeof(K);
+    header.numVertices = numVertices();
+    header.numEdges = numEdges();
+    header.numLabels = labelStarts.size() - 1;
+    header.indexCapacity = index.capacity();
+    header.indexCount = index.size();
+    header.labelBytes = labelChars.size();
+    header.scale = scale;
+    vector<uint64_t> bytes;
+    vector<uint64_t> layout = fileLayout(header, bytes);
+    header.fileBytes = layout.back();
+
+    ofstream out(filename, ios::binary | ios::trunc);
+    if (!out)
+        throw runtime_error("Error in save: cannot write " + filename);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    const void* arrays[] = {
+        keys.data(), index.table(), coords.data(), offsets.data(), targets.data(), weights.data(),
+        labelIds.data(), labelStarts.data(), labelChars.data(), rOffsets.data(), rSources.data(), rEdges.data()
+    };
+    uint64_t at = sizeof(header);
+    for (size_t i = 0; i < 12; i++) {
+        const char zeros[16] = {};
+        out.write(zeros, layout[i] - at);
+        out.write(static_cast<const char*>(arrays[i]), bytes[i]);
+        at = layout[i] + bytes[i];
+    }
+    if (!out)
+        throw runtime_error("Error in save: cannot write " + filename);
+}
+
+//=================================================================
+// open
+// Opens a graph written by save(). The file is mapped rather than
+//   read, so opening does no parsing; one O(V+E) pass checks that
+//   every stored index is in range before any search can follow it.
+// Parameters:  filename - path of a file written by save()
+// Returns:     the graph, reading its arrays from the mapped file
+// Throws:      runtime_error if the file cannot be opened, is not a
+//              graph saved by this version with the same key type,
+//              or is corrupt
+//=================================================================
+template <class K, class D>
+CompactGraph<K,D> CompactGraph<K,D>::open ( const string& filename )
+{
+    shared_ptr<const MappedFile> mapped = make_shared<const MappedFile>(filename);
+    FileHeader header;
+    if (mapped->size() < sizeof(header))
+        throw runtime_error("Error in open: " + filename + " is not a saved graph");
+    memcpy(&header, mapped->data(), sizeof(header));
+    if (memcmp(header.magic, "CSRGRAPH", 8) != 0)
+        throw runtime_error("Error in open: " + filename + " is not a saved graph");
+    if (header.version != FILE_VERSION)
+        throw runtime_error("Error in open: " + filename + " has format version " + to_string(header.version));
+    if (header.keyBytes != sizeof(K))
+        throw runtime_error("Error in open: " + filename + " was saved with a different key type");
+    // a huge label size could wrap the layout sums around
+    if (header.labelBytes > mapped->size())
+        throw runtime_error("Error in open: " + filename + " is truncated");
+    vector<uint64_t> bytes;
+    vector<uint64_t> layout = fileLayout(header, bytes);
+    if (header.fileBytes != layout.back() || mapped->size() != layout.back())
+        throw runtime_error("Error in open: " + filename + " is truncated");
+
+    const char* base = mapped->data();
+    uint32_t n = header.numVertices;
+    uint32_t m = header.numEdges;
+    CompactGraph<K,D> g;
+    g.keys.view(reinterpret_cast<const K*>(base + layout[0]), n);
+    g.index.view(reinterpret_cast<const typename KeyIndex<K>::Slot*>(base + layout[1]), header.indexCapacity, header.indexCount);
+    g.coords.view(reinterpret_cast<const double*>(base + layout[2]), 2 * size_t(n));
+    g.offsets.view(reinterpret_cast<const uint32_t*>(base + layout[3]), n + size_t(1));
+    g.targets.view(reinterpret_cast<const uint32_t*>(base + layout[4]), m);
+    g.weights.view(reinterpret_cast<const double*>(base + layout[5]), m);
+    g.labelIds.view(reinterpret_cast<const uint32_t*>(base + layout[6]), m);
+    g.labelStarts.view(reinterpret_cast<const uint64_t*>(base + layout[7]), header.numLabels + size_t(1));
+    g.labelChars.view(base + layout[8], header.labelBytes);
+    g.rOffsets.view(reinterpret_cast<const uint32_t*>(base + layout[9]), n + size_t(1));
+    g.rSources.view(reinterpret_cast<const uint32_t*>(base + layout[10]), m);
+    g.rEdges.view(reinterpret_cast<const uint32_t*>(base + layout[11]), m);
+    g.scale = header.scale;
+    g.file = mapped;
+    g.validate(filename);
+    return g;
+}
+
+//=================================================================
+// validate
+// Checks the arrays of an opened file against each other, so a
+//   corrupt, hand-edited or foreign-endian file is refused instead
+//   of sending a search out of bounds. Weights and coordinates are
+//   not checked; any value is safe to read.
+// Parameters:  filename - name of the file, for the error message
+// Returns:     none
+// Throws:      runtime_error naming the first bad array
+//=================================================================
+template <class K, class D>
+void CompactGraph<K,D>::validate ( const string& filename ) const
+{
+    auto corrupt = [&](const string& what) {
+        throw runtime_error("Error in open: " + filename + " is corrupt (" + what + ")");
+    };
+    uint32_t n = numVertices();
+    uint32_t m = numEdges();
+    uint32_t numLabels = labelStarts.size() - 1;
+
+    // each list must lie inside the edge arrays, in order
+    for (const MappedArray<uint32_t>* starts : { &offsets, &rOffsets }) {
+        if ((*starts)[0] != 0 || (*starts)[n] != m)
+            corrupt("offsets");
+        for (uint32_t u = 0; u < n; u++) {
+            if ((*starts)[u] > (*starts)[u + 1])
+                corrupt("offsets");
+        }
+    }
+    for (uint32_t e = 0; e < m; e++) {
+        if (targets[e] >= n || rSources[e] >= n)
+            corrupt("edge endpoints");
+        if (rEdges[e] >= m)
+            corrupt("reverse edges");
+        if (labelIds[e] >= numLabels)
+            corrupt("edge labels");
+    }
+    if (labelStarts[0] != 0 || labelStarts[numLabels] > labelChars.size())
+        corrupt("label table");
+    for (uint32_t i = 0; i < numLabels; i++) {
+        if (labelStarts[i] > labelStarts[i + 1])
+            corrupt("label table");
+    }
+
+    // find() probes until an empty slot, so one must exist, and every
+    // stored index must name the vertex with that key
+    uint32_t capacity = index.capacity();
+    if (capacity < 2 || (capacity & (capacity - 1)) != 0 || index.size() != n)
+        corrupt("key index");
+    const typename KeyIndex<K>::Slot* slots = index.table();
+    uint32_t used = 0;
+    for (uint32_t i = 0; i < capacity; i++) {
+        if (slots[i].index == NO_VERTEX)
+            continue;
+        if (slots[i].index >= n || !(keys[slots[i].index] == slots[i].key))
+            corrupt("key index");
+        used++;
+    }
+    if (used != n || used == capacity)
+        corrupt("key index");
+}
+
+//=================================================================
+// indexOf
+// Looks up the dense index of a vertex key
+// Parameters:  key - key of the vertex
+// Returns:     index of the vertex, NO_VERTEX if it does not exist
+//=================================================================
+template <class K, class D>
+uint32_t CompactGraph<K,D>::indexOf ( K key ) const
+{
+    return index.find(key);
+}
+
+//=================================================================
+// isEdge
+// Checks if there is an edge between two vertices
+// Parameters:  v1 - key of the first vertex
+//              v2 - key of the second vertex
+// Returns:     true if edge exists in graph, false otherwise
+// Throws:      invalid_argument if either vertex is not found
+//=================================================================
+template <class K, class D>
+bool CompactGraph<K,D>::isEdge ( K v1, K v2 ) const
+{
+    uint32_t u = indexOf(v1);
+    uint32_t v = indexOf(v2);
+    if (u == NO_VERTEX || v == NO_VERTEX)
+        throw invalid_argument("Error in isEdge: One or both vertices not found.");
+    // an edge may weigh INT_MAX, so look for it rather than its weight
+    for (uint32_t e = offsets[u]; e < offsets[u + 1]; e++) {
+        if (targets[e] == v)
+            return true;
+    }
+    return false;
+}
+
+//=================================================================
+// getWeight
+// Returns the weight of the edge between two vertices
+// Parameters:  v1 - key of the first vertex
+//              v2 - key of the second vertex
+// Returns:     weight of the edge if it exists, INT_MAX otherwise
+//=================================================================
+template <class K, class D>
+double CompactGraph<K,D>::getWeight ( K v1, K v2 ) const
+{
+    uint32_t u = indexOf(v1);
+    uint32_t v = indexOf(v2);
+    if (u == NO_VERTEX || v == NO_VERTEX)
+        throw invalid_argument("Error in getWeight: One or both vertices not found.");
+    for (uint32_t e = offsets[u]; e < offsets[u + 1]; e++) {
+        if (targets[e] == v)
+            return weights[e];
+    }
+    return INT_MAX;
+}
+
+//=================================================================
+// DFS
+// Performs Depth-First Search on the snapshot, visiting roots in
+//   vertex index order like Graph::DFS
+// Parameters:  ctx - receives colors, predecessors and times
+// Returns:     none
+//=================================================================
+template <class K, class D>
+void CompactGraph<K,D>::DFS ( SearchContext& ctx ) const
+{
+    depthFirstSearch(*this, ctx);
+}
+
+//=================================================================
+// DFS
+// Performs Depth-First Search, reporting each discovery, finish and
+//   examined edge to the visitor as it happens (see DFSVisitor)
+// Parameters:  ctx - receives colors, predecessors and times
+//              visitor - receives the search events
+// Returns:     none
+//=================================================================
+template <class K, class D>
+template <class V>
+void CompactGraph<K,D>::DFS ( SearchContext& ctx, V& visitor ) const
+{
+    depthFirstSearch(*this, ctx, visitor);
+}
+
+//=================================================================
+// topologicalOrder
+// Orders the vertex keys so that every edge points forward, using
+//   Kahn's algorithm; same order as Graph::topologicalOrder
+// Parameters:  none
+// Returns:     keys in topological order
+// Throws:      invalid_argument naming a cycle if the graph is not a DAG
+//=================================================================
+template <class K, class D>
+vector<K> CompactGraph<K,D>::topologicalOrder ( ) const
+{
+    vector<uint32_t> order;
+    vector<uint32_t> levels;
+    kahnTopologicalSort(*this, order, levels);
+    requireAcyclic(*this, order, "topologicalSort");
+
+    vector<K> result;
+    result.reserve(order.size());
+    for (uint32_t u : order)
+        result.push_back(keys[u]);
+    return result;
+}
+
+//=================================================================
+// topologicalSort
+// Returns a string representing the topological sort of the graph
+// Parameters:  none
+// Returns:     string representation of the topological sort
+// Throws:      invalid_argument naming a cycle if the graph is not a DAG
+//=================================================================
+template <class K, class D>
+string CompactGraph<K,D>::topologicalSort ( ) const
+{
+    stringstream ss;
+    bool first = true;
+    for (const K& key : topologicalOrder()) {
+        if (!first)
+            ss << "->";
+        ss << key;
+        first = false;
+    }
+    return ss.str();
+}
+
+//=================================================================
+// topologicalLevels
+// Splits a topological order into wavefronts of vertices that are
+//   independent of each other; see Graph::topologicalLevels
+// Parameters:  none
+// Returns:     the wavefronts in order, each in index order
+// Throws:      invalid_argument naming a cycle if the graph is not a DAG
+//=================================================================
+template <class K, class D>
+vector<vector<K>> CompactGraph<K,D>::topologicalLevels ( ) const
+{
+    vector<uint32_t> order;
+    vector<uint32_t> levels;
+    kahnTopologicalSort(*this, order, levels);
+    requireAcyclic(*this, order, "topologicalLevels");
+    return wavefronts(order, levels);
+}
+
+//=================================================================
+// topologicalLevels
+// Same as above, computing each wavefront on the threads of a pool
+// Parameters:  pool - threads to run on
+// Returns:     the wavefronts in order, each in index order
+// Throws:      invalid_argument naming a cycle if the graph is not a DAG
+//=================================================================
+template <class K, class D>
+vector<vector<K>> CompactGraph<K,D>::topologicalLevels ( ThreadPool& pool ) const
+{
+    vector<uint32_t> order;
+    vector<uint32_t> levels;
+    parallelKahnTopologicalSort(*this, order, levels, pool);
+    requireAcyclic(*this, order, "topologicalLevels");
+    return wavefronts(order, levels);
+}
+
+//=================================================================
+// wavefronts
+// Turns a leveled order of vertex indices into lists of keys
+// Parameters:  order - vertex indices, wavefront by wavefront
+//              levels - start of each wavefront, then order.size()
+// Returns:     the keys of each wavefront
+//=================================================================
+template <class K, class D>
+vector<vector<K>> CompactGraph<K,D>::wavefronts ( const vector<uint32_t>& order, const vector<uint32_t>& levels ) const
+{
+    vector<vector<K>> result(levels.size() - 1);
+    for (size_t l = 0; l + 1 < levels.size(); l++) {
+        result[l].reserve(levels[l + 1] - levels[l]);
+        for (uint32_t i = levels[l]; i < levels[l + 1]; i++)
+            result[l].push_back(keys[order[i]]);
+    }
+    return result;
+}
+
+//=================================================================
+// BFS
+// Performs Breadth-First Search starting from the given source vertex
+// Parameters:  source - the starting vertex for BFS
+//              ctx - receives distances and predecessors
+// Returns:     none
+//=================================================================
+template <class K, class D>
+void CompactGraph<K,D>::BFS ( K source, SearchContext& ctx ) const
+{
+    uint32_t s = indexOf(source);
+    if (s == NO_VERTEX)
+        throw invalid_argument("Error in BFS: Source vertex not found.");
+    breadthFirstSearch(*this, s, ctx);
+}
+
+//=================================================================
+// BFS
+// Multi-threaded Breadth-First Search. Leaves the same distances and
+//   predecessors in ctx as the sequential BFS above.
+// Parameters:  source - the starting vertex for BFS
+//              ctx - receives distances and predecessors
+//              pool - threads to run on
+// Returns:     none
+//=================================================================
+template <class K, class D>
+void CompactGraph<K,D>::BFS ( K source, SearchContext& ctx, ThreadPool& pool ) const
+{
+    uint32_t s = indexOf(source);
+    if (s == NO_VERTEX)
+        throw invalid_argument("Error in BFS: Source vertex not found.");
+    parallelBreadthFirstSearch(*this, s, ctx, pool);
+}
+
+//=================================================================
+// dijkstra
+// Computes single source shortest paths with non-negative weights
+// Parameters:  s - source vertex key
+//              ctx - receives distances and predecessors
+// Returns:     none
+//=================================================================
+template <class K, class D>
+void CompactGraph<K,D>::dijkstra ( K s, SearchContext& ctx ) const
+{
+    uint32_t src = indexOf(s);
+    if (src == NO_VERTEX)
+        throw invalid_argument("Error in dijkstra: Source vertex not found.");
+    dijkstraSearch(*this, src, ctx);
+}
+
+//=================================================================
+// deltaStepping
+// Computes single source shortest paths on the threads of a pool.
+//   Leaves the same distances and predecessors in ctx as dijkstra.
+// Parameters:  s - source vertex key
+//              ctx - receives distances and predecessors
+//              pool - threads to run on
+//              delta - bucket width, <= 0 for the mean edge weight
+// Returns:     none
+//=================================================================
+template <class K, class D>
+void CompactGraph<K,D>::deltaStepping ( K s, SearchContext& ctx, ThreadPool& pool, double delta ) const
+{
+    uint32_t src = indexOf(s);
+    if (src == NO_VERTEX)
+        throw invalid_argument("Error in deltaStepping: Source vertex not found.");
+    deltaSteppingSearch(*this, src, ctx, pool, delta);
+}
+
+//=================================================================
+// shortestPath
+// Finds the shortest path between two vertices using the calling
+//   thread's search context
+// Parameters:  s - source vertex key
+//              d - destination vertex key
+//              weighted - use edge weights (dijkstra) instead of hops (BFS)
+// Returns:     string representation of the shortest path
+//=================================================================
+template <class K, class D>
+string CompactGraph<K,D>::shortestPath ( K s, K d, bool weighted ) const
+{
+    return shortestPath(s, d, weighted, SearchContext::local());
+}
+
+//=================================================================
+// shortestPath
+// Finds the shortest path between two vertices. The result has the
+//   same format as Graph::shortestPath.
+// Parameters:  s - source vertex key
+//              d - destination vertex key
+//              weighted - use edge weights (dijkstra) instead of hops (BFS)
+//              ctx - context for the search
+// Returns:     string representation of the shortest path
+//=================================================================
+template <class K, class D>
+string CompactGraph<K,D>::shortestPath ( K s, K d, bool weighted, SearchContext& ctx ) const
+{
+    uint32_t src = indexOf(s);
+    uint32_t dst = indexOf(d);
+    if (src == NO_VERTEX || dst == NO_VERTEX)
+        return "Either one or both of your input keys don't exist as a vertex.";
+
+    return formatPathText(*this, findPath(s, d, weighted, ctx));
+}
+
+//=================================================================
+// findPath
+// Finds the shortest path between two vertices using the calling
+//   thread's search context
+// Parameters:  s - source vertex key
+//              d - destination vertex key
+//              weighted - use dijkstra instead of BFS
+// Returns:     the path, empty if d cannot be reached
+// Throws:      invalid_argument if either vertex is not found
+//=================================================================
+template <class K, class D>
+Path CompactGraph<K,D>::findPath ( K s, K d, bool weighted ) const
+{
+    return findPath(s, d, weighted, SearchContext::local());
+}
+
+//=================================================================
+// findPath
+// Same as above, keeping the search state in the given context
+// Parameters:  s - source vertex key
+//              d - destination vertex key
+//              weighted - use dijkstra instead of BFS
+//              ctx - context for the search
+// Returns:     the path, empty if d cannot be reached
+// Throws:      invalid_argument if either vertex is not found
+//=================================================================
+template <class K, class D>
+Path CompactGraph<K,D>::findPath ( K s, K d, bool weighted, SearchContext& ctx ) const
+{
+    uint32_t src = indexOf(s);
+    uint32_t dst = indexOf(d);
+    if (src == NO_VERTEX || dst == NO_VERTEX)
+        throw invalid_argument("Error in findPath: One or both vertices not found.");
+
+    if (!weighted) {
+        breadthFirstSearch(*this, src, ctx);
+    } else {
+        dijkstraSearch(*this, src, ctx);
+    }
+    return tracePath(*this, src, dst, weighted, ctx);
+}
+
+//=================================================================
+// shortestPath
+// Finds the shortest path between the vertices nearest to two
+//   coordinates (see nearestVertex)
+// Parameters:  from - (longitude, latitude) of the start
+//              to - (longitude, latitude) of the destination
+//              weighted - use dijkstra instead of BFS
+// Returns:     string representation of the shortest path
+// Throws:      invalid_argument if the graph has no vertices
+//=================================================================
+template <class K, class D>
+string CompactGraph<K,D>::shortestPath ( const tuple<double, double>& from, const tuple<double, double>& to, bool weighted ) const
+{
+    K s = nearestVertex(get<0>(from), get<1>(from));
+    K d = nearestVertex(get<0>(to), get<1>(to));
+    return shortestPath(s, d, weighted);
+}
+
+//=================================================================
+// findPath
+// Finds the shortest path between the vertices nearest to two
+//   coordinates (see nearestVertex)
+// Parameters:  from - (longitude, latitude) of the start
+//              to - (longitude, latitude) of the destination
+//              weighted - use dijkstra instead of BFS
+// Returns:     the path, empty if the destination cannot be reached
+// Throws:      invalid_argument if the graph has no vertices
+//=================================================================
+template <class K, class D>
+Path CompactGraph<K,D>::findPath ( const tuple<double, double>& from, const tuple<double, double>& to, bool weighted ) const
+{
+    K s = nearestVertex(get<0>(from), get<1>(from));
+    K d = nearestVertex(get<0>(to), get<1>(to));
+    return findPath(s, d, weighted);
+}
+
+//=================================================================
+// spatialIndex
+// The k-d tree over vertex coordinates. A snapshot taken after the
+//   graph built its tree shares it; otherwise, as after open(), the
+//   first query builds it and later ones share it.
+// Parameters:  none
+// Returns:     the index
+//=================================================================
+template <class K, class D>
+shared_ptr<const KdTree> CompactGraph<K,D>::spatialIndex ( ) const
+{
+    shared_ptr<const KdTree> tree = atomic_load(&spatial);
+    if (!tree) {
+        tree = make_shared<const KdTree>(*this);
+        atomic_store(&spatial, tree);
+    }
+    return tree;
+}
+
+//=================================================================
+// nearestVertex
+// Snaps a coordinate to the closest vertex by great-circle distance
+// Parameters:  lon, lat - coordinate in degrees
+// Returns:     key of the closest vertex
+// Throws:      invalid_argument if the graph has no vertices
+//=================================================================
+template <class K, class D>
+K CompactGraph<K,D>::nearestVertex ( double lon, double lat ) const
+{
+    uint32_t u = spatialIndex()->nearest(lon, lat);
+    if (u == NO_VERTEX)
+        throw invalid_argument("Error in nearestVertex: Graph has no vertices.");
+    return keys[u];
+}
+
+//=================================================================
+// nearestVertices
+// The k vertices closest to a coordinate by great-circle distance
+// Parameters:  lon, lat - coordinate in degrees
+//              k - number of vertices wanted
+// Returns:     keys of up to k vertices, closest first
+//=================================================================
+template <class K, class D>
+vector<K> CompactGraph<K,D>::nearestVertices ( double lon, double lat, uint32_t k ) const
+{
+    vector<K> result;
+    for (uint32_t u : spatialIndex()->nearest(lon, lat, k))
+        result.push_back(keys[u]);
+    return result;
+}
+
+//=================================================================
+// verticesWithin
+// Every vertex within a great-circle distance of a coordinate
+// Parameters:  lon, lat - coordinate in degrees
+//              meters - the distance
+// Returns:     keys of the vertices, closest first
+//=================================================================
+template <class K, class D>
+vector<K> CompactGraph<K,D>::verticesWithin ( double lon, double lat, double meters ) const
+{
+    vector<K> result;
+    for (uint32_t u : spatialIndex()->within(lon, lat, meters))
+        result.push_back(keys[u]);
+    return result;
+}
+
+//=================================================================
+// verticesInBox
+// Every vertex inside a longitude/latitude box. A box with minLon
+//   greater than maxLon wraps across the antimeridian.
+// Parameters:  minLon, minLat, maxLon, maxLat - the box in degrees
+// Returns:     keys of the vertices, in vertex index order
+//=================================================================
+template <class K, class D>
+vector<K> CompactGraph<K,D>::verticesInBox ( double minLon, double minLat, double maxLon, double maxLat ) const
+{
+    vector<K> result;
+    for (uint32_t u : spatialIndex()->inBox(minLon, minLat, maxLon, maxLat))
+        result.push_back(keys[u]);
+    return result;
+}
+
+//=================================================================
+// distanceTable
+// Shortest weighted distances from each source to each target, on
+//   several threads. Each source runs one dijkstra that stops once
+//   every target is settled, instead of one full search per pair.
+// Parameters:  sources - source vertex keys, one row each
+//              targets - target vertex keys, one column each
+//              threads - number of threads, 0 for one per core
+// Returns:     sources.size() x targets.size() matrix of distances,
+//              SearchContext::INF where a target cannot be reached
+// Throws:      invalid_argument if a vertex is not found
+//=================================================================
+template <class K, class D>
+Matrix<double> CompactGraph<K,D>::distanceTable ( const vector<K>& sources, const vector<K>& targets, unsigned threads ) const
+{
+    ThreadPool pool(threads > 0 ? threads : thread::hardware_concurrency());
+    return distanceTable(sources, targets, pool);
+}
+
+//=================================================================
+// distanceTable
+// Same as above on the threads of a pool
+// Parameters:  sources - source vertex keys, one row each
+//              targets - target vertex keys, one column each
+//              pool - threads to run on
+// Returns:     sources.size() x targets.size() matrix of distances
+// Throws:      invalid_argument if a vertex is not found
+//=================================================================
+template <class K, class D>
+Matrix<double> CompactGraph<K,D>::distanceTable ( const vector<K>& sources, const vector<K>& targets, ThreadPool& pool ) const
+{
+    vector<uint32_t> from(sources.size());
+    vector<uint32_t> to(targets.size());
+    for (size_t i = 0; i < sources.size(); i++)
+        from[i] = indexOf(sources[i]);
+    for (size_t j = 0; j < targets.size(); j++)
+        to[j] = indexOf(targets[j]);
+    if (find(from.begin(), from.end(), NO_VERTEX) != from.end() || find(to.begin(), to.end(), NO_VERTEX) != to.end())
+        throw invalid_argument("Error in distanceTable: Vertex not found.");
+    return distanceTableSearch(*this, from, to, pool);
+}
+
+//=================================================================
+// astar
+// Finds the shortest weighted path between two vertices with A*
+//   using the calling thread's search context
+// Parameters:  s - source vertex key
+//              d - destination vertex key
+// Returns:     string representation of the shortest path
+//=================================================================
+template <class K, class D>
+string CompactGraph<K,D>::astar ( K s, K d ) const
+{
+    return astar(s, d, SearchContext::local());
+}
+
+//=================================================================
+// astar
+// Finds the shortest weighted path between two vertices with A*.
+//   The result is the same as shortestPath(s, d, true).
+// Parameters:  s - source vertex key
+//              d - destination vertex key
+//              ctx - context for the search
+// Returns:     string representation of the shortest path
+//=================================================================
+template <class K, class D>
+string CompactGraph<K,D>::astar ( K s, K d, SearchContext& ctx ) const
+{
+    uint32_t src = indexOf(s);
+    uint32_t dst = indexOf(d);
+    if (src == NO_VERTEX || dst == NO_VERTEX)
+        return "Either one or both of your input keys don't exist as a vertex.";
+
+    astarSearch(*this, src, dst, ctx);
+    return formatPathText(*this, tracePath(*this, src, dst, true, ctx));
+}
+
+//=================================================================
+// shortestPathBidirectional
+// Finds the shortest path between two vertices by searching forward
+//   from s and backward from d until the searches meet, using the
+//   calling thread's search contexts
+// Parameters:  s - source vertex key
+//              d - destination vertex key
+//              weighted - bidirectional dijkstra instead of BFS
+// Returns:     string representation of the shortest path
+//=================================================================
+template <class K, class D>
+string CompactGraph<K,D>::shortestPathBidirectional ( K s, K d, bool weighted ) const
+{
+    return shortestPathBidirectional(s, d, weighted, SearchContext::local(0), SearchContext::local(1));
+}
+
+//=================================================================
+// shortestPathBidirectional
+// Same as above with explicit contexts for the two searches
+// Parameters:  s - source vertex key
+//              d - destination vertex key
+//              weighted - bidirectional dijkstra instead of BFS
+//              fwd - context for the forward search; receives the path
+//              bwd - context for the backward search
+// Returns:     string representation of the shortest path
+//=================================================================
+template <class K, class D>
+string CompactGraph<K,D>::shortestPathBidirectional ( K s, K d, bool weighted, SearchContext& fwd, SearchContext& bwd ) const
+{
+    uint32_t src = indexOf(s);
+    uint32_t dst = indexOf(d);
+    if (src == NO_VERTEX || dst == NO_VERTEX)
+        return "Either one or both of your input keys don't exist as a vertex.";
+
+    if (!weighted) {
+        bidirectionalBFS(*this, src, dst, fwd, bwd);
+    } else {
+        bidirectionalDijkstra(*this, src, dst, fwd, bwd);
+    }
+    return formatPathText(*this, tracePath(*this, src, dst, weighted, fwd));
+}
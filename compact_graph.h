@@ -0,0 +1,145 @@
+//=================================================================
+// CS 271 - Project 6
+// compact_graph.h
+// Fall 2025
+// This is the declaration file for the CompactGraph class, an
+// immutable compressed sparse row (CSR) snapshot of a Graph
+//=================================================================
+
+#ifndef COMPACT_GRAPH_H
+#define COMPACT_GRAPH_H
+
+#include <string>
+#include <vector>
+#include <tuple>
+#include <cstdint>
+#include <memory>
+#include "graph.h"
+#include "key_index.h"
+#include "mapped_file.h"
+#include "search_context.h"
+#include "graph_search.h"
+#include "path.h"
+#include "kd_tree.h"
+#include "vertex_order.h"
+using namespace std;
+
+template <class K, class D>
+class ContractionHierarchy;
+
+template <class K, class D>
+class CompactGraph
+{
+   friend class ContractionHierarchy<K,D>;
+private:
+   // Every array either owns its elements or reads them from a file
+   // opened with open(), which file keeps mapped.
+   // topology: the out-edges of vertex i are targets[offsets[i] .. offsets[i+1])
+   MappedArray<K>                 keys;      // vertex index -> key
+   KeyIndex<K>                    index;     // key -> vertex index
+   MappedArray<double>            coords;    // 2 * numV entries, (x, y) of each vertex
+   MappedArray<uint32_t>          offsets;   // numV + 1 entries
+   MappedArray<uint32_t>          targets;   // numE entries, target vertex index
+   MappedArray<double>            weights;   // numE entries, parallel to targets
+   MappedArray<uint32_t>          labelIds;  // numE entries, index into the label table
+   MappedArray<uint64_t>          labelStarts; // numLabels + 1 entries, into labelChars
+   MappedArray<char>              labelChars;  // interned edge labels, back to back
+
+   // reverse topology: the in-edges of vertex i are rEdges[rOffsets[i] .. rOffsets[i+1]),
+   // each the position of the forward edge in targets/weights/labelIds
+   MappedArray<uint32_t>          rOffsets;  // numV + 1 entries
+   MappedArray<uint32_t>          rSources;  // numE entries, source vertex index
+   MappedArray<uint32_t>          rEdges;    // numE entries, forward edge position
+   double                         scale;     // A* scale, see heuristicScale
+   shared_ptr<const MappedFile>   file;      // backing file of a graph from open()
+   mutable shared_ptr<const KdTree> spatial; // vertex coordinates, built on first use
+   shared_ptr<const KdTree> spatialIndex ( ) const;
+
+   // Layout of a saved graph: a FileHeader, then keys, index slots,
+   // coords, offsets, targets, weights, labelIds, labelStarts,
+   // labelChars, rOffsets, rSources and rEdges, each starting at a
+   // multiple of 16 bytes. Numbers are in the machine's byte order.
+   struct FileHeader
+   {
+       char     magic[8];       // "CSRGRAPH"
+       uint32_t version;        // FILE_VERSION
+       uint32_t keyBytes;       // sizeof(K)
+       uint32_t numVertices;
+       uint32_t numEdges;
+       uint32_t numLabels;
+       uint32_t indexCapacity;
+       uint32_t indexCount;
+       uint32_t unused;
+       uint64_t labelBytes;
+       double   scale;
+       uint64_t fileBytes;      // total size, to catch truncated files
+   };
+   static constexpr uint32_t FILE_VERSION = 1;
+   static vector<uint64_t> fileLayout ( const FileHeader& header, vector<uint64_t>& bytes );
+   void     validate     ( const string& filename ) const;
+
+   string   label        ( uint32_t id ) const { return string(labelChars.data() + labelStarts[id], labelChars.data() + labelStarts[id + 1]); }
+
+   vector<vector<K>> wavefronts ( const vector<uint32_t>& order, const vector<uint32_t>& levels ) const;
+public:
+   typedef uint32_t EdgeIterator;   // position in targets/weights/labelIds
+   typedef uint32_t InEdgeIterator; // position in rSources/rEdges
+
+            CompactGraph   ( );
+            CompactGraph   ( const Graph<K,D>& g, VertexOrder order = VertexOrder::Insertion );
+
+   void     save           ( const string& filename ) const;
+   static CompactGraph open ( const string& filename );
+
+   uint32_t numVertices    ( ) const { return keys.size(); }
+   uint32_t numEdges       ( ) const { return targets.size(); }
+   uint32_t indexOf        ( K key ) const;
+   const K& keyAt          ( uint32_t u ) const { return keys[u]; }
+   bool     isEdge         ( K v1, K v2 ) const;
+   double   getWeight      ( K v1, K v2 ) const;
+   void     DFS            ( SearchContext& ctx ) const;
+   template <class V>
+   void     DFS            ( SearchContext& ctx, V& visitor ) const;
+   vector<K> topologicalOrder ( ) const;
+   string   topologicalSort( ) const;
+   vector<vector<K>> topologicalLevels ( ) const;
+   vector<vector<K>> topologicalLevels ( ThreadPool& pool ) const;
+   void     BFS            ( K source, SearchContext& ctx ) const;
+   void     BFS            ( K source, SearchContext& ctx, ThreadPool& pool ) const;
+   void     dijkstra       ( K s, SearchContext& ctx ) const;
+   void     deltaStepping  ( K s, SearchContext& ctx, ThreadPool& pool, double delta = 0 ) const;
+   string   shortestPath   ( K s, K d, bool weighted = false ) const;
+   string   shortestPath   ( K s, K d, bool weighted, SearchContext& ctx ) const;
+   Path     findPath       ( K s, K d, bool weighted = false ) const;
+   Path     findPath       ( K s, K d, bool weighted, SearchContext& ctx ) const;
+   string   shortestPath   ( const tuple<double, double>& from, const tuple<double, double>& to, bool weighted = false ) const;
+   Path     findPath       ( const tuple<double, double>& from, const tuple<double, double>& to, bool weighted = false ) const;
+   K        nearestVertex  ( double lon, double lat ) const;
+   vector<K> nearestVertices ( double lon, double lat, uint32_t k ) const;
+   vector<K> verticesWithin ( double lon, double lat, double meters ) const;
+   vector<K> verticesInBox ( double minLon, double minLat, double maxLon, double maxLat ) const;
+   Matrix<double> distanceTable ( const vector<K>& sources, const vector<K>& targets, unsigned threads = 0 ) const;
+   Matrix<double> distanceTable ( const vector<K>& sources, const vector<K>& targets, ThreadPool& pool ) const;
+   string   astar          ( K s, K d ) const;
+   string   astar          ( K s, K d, SearchContext& ctx ) const;
+   string   shortestPathBidirectional ( K s, K d, bool weighted = false ) const;
+   string   shortestPathBidirectional ( K s, K d, bool weighted, SearchContext& fwd, SearchContext& bwd ) const;
+
+   // adjacency access used by the algorithms in graph_search.h
+   EdgeIterator edgesBegin ( uint32_t u ) const { return offsets[u]; }
+   EdgeIterator edgesEnd   ( uint32_t u ) const { return offsets[u + 1]; }
+   uint32_t     edgeTarget ( EdgeIterator e ) const { return targets[e]; }
+   double       edgeWeight ( EdgeIterator e ) const { return weights[e]; }
+   string       edgeLabel  ( EdgeIterator e ) const { return label(labelIds[e]); }
+   uint32_t     edgeId     ( EdgeIterator e ) const { return e; }
+   uint32_t     outDegree  ( uint32_t u ) const { return offsets[u + 1] - offsets[u]; }
+   InEdgeIterator inEdgesBegin ( uint32_t v ) const { return rOffsets[v]; }
+   InEdgeIterator inEdgesEnd   ( uint32_t v ) const { return rOffsets[v + 1]; }
+   uint32_t     inEdgeSource ( InEdgeIterator e ) const { return rSources[e]; }
+   double       inEdgeWeight ( InEdgeIterator e ) const { return weights[rEdges[e]]; }
+   uint32_t     inEdgeId     ( InEdgeIterator e ) const { return rEdges[e]; }
+   tuple<double, double> vertexData ( uint32_t u ) const { return make_tuple(coords[2 * u], coords[2 * u + 1]); }
+   double       heuristicScale ( ) const { return scale; }
+};
+#include "compact_graph.cpp"
+#endif
@@ -0,0 +1,645 @@
+//=================================================================
+// CS 271 - Project 6
+// contraction_hierarchy.cpp
+// Fall 2025
+// This is the implementation file for the ContractionHierarchy class
+//=================================================================
+
+#include <algorithm>
+#include <stdexcept>
+
+
+//=================================================================
+// Default constructor
+// Creates an empty hierarchy
+// Parameters:  none
+// Returns:     none
+//=================================================================
+template <class K, class D>
+ContractionHierarchy<K,D>::ContractionHierarchy ( )
+{
+    upOffsets.push_back(0);
+    downOffsets.push_back(0);
+    shortcuts = 0;
+}
+
+//=================================================================
+// Constructor
+// Preprocesses a graph. Later changes to the graph are not
+//   reflected in the hierarchy.
+// Parameters:  g - the graph to preprocess
+// Returns:     none
+//=================================================================
+template <class K, class D>
+ContractionHierarchy<K,D>::ContractionHierarchy ( const Graph<K,D>& g ) : base(g)
+{
+    build();
+}
+
+//=================================================================
+// Constructor
+// Preprocesses a snapshot of a graph
+// Parameters:  g - the snapshot to preprocess
+// Returns:     none
+//=================================================================
+template <class K, class D>
+ContractionHierarchy<K,D>::ContractionHierarchy ( const CompactGraph<K,D>& g ) : base(g)
+{
+    build();
+}
+
+//=================================================================
+// addArc
+// Appends an original edge or a shortcut to the arc list
+// Parameters:  from - source vertex index
+//              to - target vertex index
+//              weight - length of the arc
+//              first - edge position in base, or first half of a shortcut
+//              second - second half of a shortcut, NO_VERTEX for an edge
+// Returns:     id of the new arc
+//=================================================================
+template <class K, class D>
+uint32_t ContractionHierarchy<K,D>::addArc ( uint32_t from, uint32_t to, double weight, uint32_t first, uint32_t second )
+{
+    arcs.push_back(Arc{from, to, weight, first, second});
+    return arcs.size() - 1;
+}
+
+//=================================================================
+// findShortcuts
+// Lists the shortcuts contracting v would need. For every in-arc
+//   u -> v a dijkstra from u over the remaining graph without v looks
+//   for witnesses; a pair u -> v -> w needs a shortcut unless some
+//   path u -> w found there is no longer. The search gives up after
+//   WITNESS_LIMIT vertices, which can only add unneeded shortcuts.
+// Parameters:  v - vertex to contract
+//              out - out-arcs of every remaining vertex
+//              in - in-arcs of every remaining vertex
+//              witness - context for the witness searches
+//              needed - receives (in-arc, out-arc) pairs to shortcut
+// Returns:     none
+//=================================================================
+template <class K, class D>
+void ContractionHierarchy<K,D>::findShortcuts ( uint32_t v, const vector<vector<uint32_t>>& out, const vector<vector<uint32_t>>& in,
+                                                SearchContext& witness, vector<pair<uint32_t, uint32_t>>& needed ) const
+{
+    needed.clear();
+    double maxOut = 0;
+    for (uint32_t b : out[v])
+        maxOut = max(maxOut, arcs[b].weight);
+
+    IndexedHeap<double>& q = witness.heap();
+    for (uint32_t a : in[v]) {
+        uint32_t u = arcs[a].from;
+        double limit = arcs[a].weight + maxOut;
+
+        witness.reset(numVertices(), u);
+        witness.setDist(u, 0);
+        q.clear();
+        q.push(u, 0);
+        for (uint32_t settled = 0; !q.empty() && q.topPriority() <= limit && settled < WITNESS_LIMIT; settled++) {
+            uint32_t x = q.pop();
+            double dx = witness.getDist(x);
+            for (uint32_t c : out[x]) {
+                uint32_t y = arcs[c].to;
+                double dy = dx + arcs[c].weight;
+                if (y != v && dy < witness.getDist(y)) {
+                    witness.setDist(y, dy);
+                    q.push(y, dy);
+                }
+            }
+        }
+        q.clear();
+
+        for (uint32_t b : out[v]) {
+            uint32_t w = arcs[b].to;
+            if (w != u && witness.getDist(w) > arcs[a].weight + arcs[b].weight)
+                needed.push_back(make_pair(a, b));
+        }
+    }
+}
+
+//=================================================================
+// build
+// Contracts every vertex, cheapest first. The priority of v is its
+//   edge difference (shortcuts added minus arcs removed) plus the
+//   number of its neighbors already contracted, which spreads the
+//   contraction evenly over the graph. Priorities of the neighbors
+//   of a contracted vertex are refreshed right away; any other stale
+//   priority is recomputed when it reaches the top of the queue.
+// Parameters:  none
+// Returns:     none
+//=================================================================
+template <class K, class D>
+void ContractionHierarchy<K,D>::build ( )
+{
+    uint32_t n = base.numVertices();
+    rank.assign(n, NO_VERTEX);
+
+    // overlay of the remaining graph; arcs touching contracted vertices are removed
+    vector<vector<uint32_t>> out(n);
+    vector<vector<uint32_t>> in(n);
+    for (uint32_t u = 0; u < n; u++) {
+        for (auto e = base.edgesBegin(u); e != base.edgesEnd(u); ++e) {
+            uint32_t v = base.edgeTarget(e);
+            if (v == u)
+                continue;
+            uint32_t id = addArc(u, v, base.edgeWeight(e), e, NO_VERTEX);
+            out[u].push_back(id);
+            in[v].push_back(id);
+        }
+    }
+
+    SearchContext witness;
+    vector<pair<uint32_t, uint32_t>> needed;
+    vector<uint32_t> deleted(n, 0);
+    auto priority = [&](uint32_t v) {
+        findShortcuts(v, out, in, witness, needed);
+        return double(needed.size()) - double(in[v].size() + out[v].size()) + deleted[v];
+    };
+
+    IndexedHeap<double> order;
+    order.resize(n);
+    for (uint32_t v = 0; v < n; v++)
+        order.push(v, priority(v));
+
+    vector<vector<uint32_t>> up(n);
+    vector<vector<uint32_t>> down(n);
+    vector<uint32_t> neighbors;
+    uint32_t next = 0;
+    while (!order.empty()) {
+        uint32_t v = order.pop();
+        double p = priority(v);
+        if (!order.empty() && p > order.topPriority()) {
+            order.push(v, p);
+            continue;
+        }
+        rank[v] = next++;
+        up[v] = out[v];
+        down[v] = in[v];
+
+        // needed still holds the shortcuts for v from the priority above;
+        // a shortcut replaces any arc between the same two vertices, which
+        // the witness search proved to be longer
+        for (const auto& pair : needed) {
+            const Arc& a = arcs[pair.first];
+            const Arc& b = arcs[pair.second];
+            uint32_t u = a.from;
+            uint32_t w = b.to;
+            double weight = a.weight + b.weight;
+            auto toW = [&](uint32_t c) { return arcs[c].to == w; };
+            auto fromU = [&](uint32_t c) { return arcs[c].from == u; };
+            out[u].erase(remove_if(out[u].begin(), out[u].end(), toW), out[u].end());
+            in[w].erase(remove_if(in[w].begin(), in[w].end(), fromU), in[w].end());
+            uint32_t id = addArc(u, w, weight, pair.first, pair.second);
+            out[u].push_back(id);
+            in[w].push_back(id);
+        }
+
+        neighbors.clear();
+        for (uint32_t a : down[v]) {
+            uint32_t u = arcs[a].from;
+            out[u].erase(remove_if(out[u].begin(), out[u].end(), [&](uint32_t c) { return arcs[c].to == v; }), out[u].end());
+            neighbors.push_back(u);
+        }
+        for (uint32_t b : up[v]) {
+            uint32_t w = arcs[b].to;
+            in[w].erase(remove_if(in[w].begin(), in[w].end(), [&](uint32_t c) { return arcs[c].from == v; }), in[w].end());
+            neighbors.push_back(w);
+        }
+        vector<uint32_t>().swap(out[v]);
+        vector<uint32_t>().swap(in[v]);
+
+        sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(unique(neighbors.begin(), neighbors.end()), neighbors.end());
+        for (uint32_t x : neighbors) {
+            deleted[x]++;
+            order.push(x, priority(x));
+        }
+    }
+
+    // flatten the upward arcs into CSR form
+    shortcuts = 0;
+    upOffsets.assign(n + 1, 0);
+    downOffsets.assign(n + 1, 0);
+    upArcs.clear();
+    downArcs.clear();
+    for (uint32_t v = 0; v < n; v++) {
+        for (uint32_t a : up[v]) {
+            upArcs.push_back(a);
+            shortcuts += arcs[a].second != NO_VERTEX;
+        }
+        for (uint32_t a : down[v]) {
+            downArcs.push_back(a);
+            shortcuts += arcs[a].second != NO_VERTEX;
+        }
+        upOffsets[v + 1] = upArcs.size();
+        downOffsets[v + 1] = downArcs.size();
+    }
+}
+
+//=================================================================
+// rankOf
+// Returns the position of a vertex in the contraction order
+// Parameters:  key - key of the vertex
+// Returns:     0 for the first vertex contracted, numVertices()-1 for the last
+//=================================================================
+template <class K, class D>
+uint32_t ContractionHierarchy<K,D>::rankOf ( K key ) const
+{
+    uint32_t v = base.indexOf(key);
+    if (v == NO_VERTEX)
+        throw invalid_argument("Error in rankOf: Vertex not found.");
+    return rank[v];
+}
+
+//=================================================================
+// query
+// Bidirectional dijkstra restricted to upward arcs: forward from s
+//   over arcs toward higher rank, backward from t over arcs coming
+//   from higher rank. Each side stops once its queue minimum reaches
+//   the best meeting distance found so far.
+// Parameters:  s - index of the source vertex
+//              t - index of the target vertex
+//              fwd - context for the forward search
+//              bwd - context for the backward search
+// Returns:     index of the highest vertex on a shortest path,
+//              NO_VERTEX if t is unreachable
+//=================================================================
+template <class K, class D>
+uint32_t ContractionHierarchy<K,D>::query ( uint32_t s, uint32_t t, SearchContext& fwd, SearchContext& bwd ) const
+{
+    fwd.reset(numVertices(), s);
+    bwd.reset(numVertices(), t);
+    fwd.setDist(s, 0);
+    bwd.setDist(t, 0);
+    IndexedHeap<double>& qf = fwd.heap();
+    IndexedHeap<double>& qb = bwd.heap();
+    qf.clear();
+    qb.clear();
+    qf.push(s, 0);
+    qb.push(t, 0);
+
+    double best = SearchContext::INF;
+    uint32_t meet = NO_VERTEX;
+    while (true) {
+        bool forward = !qf.empty() && qf.topPriority() < best;
+        bool backward = !qb.empty() && qb.topPriority() < best;
+        if (!forward && !backward)
+            break;
+
+        if (forward && (!backward || qf.topPriority() <= qb.topPriority())) {
+            uint32_t u = qf.pop();
+            double du = fwd.getDist(u);
+            fwd.setSettled(u);
+            if (du + bwd.getDist(u) < best) {
+                best = du + bwd.getDist(u);
+                meet = u;
+            }
+            for (uint32_t i = upOffsets[u]; i < upOffsets[u + 1]; i++) {
+                const Arc& arc = arcs[upArcs[i]];
+                double dv = du + arc.weight;
+                if (dv < fwd.getDist(arc.to)) {
+                    fwd.setDist(arc.to, dv);
+                    fwd.setPre(arc.to, u);
+                    qf.push(arc.to, dv);
+                }
+            }
+        } else {
+            uint32_t u = qb.pop();
+            double du = bwd.getDist(u);
+            bwd.setSettled(u);
+            if (du + fwd.getDist(u) < best) {
+                best = du + fwd.getDist(u);
+                meet = u;
+            }
+            for (uint32_t i = downOffsets[u]; i < downOffsets[u + 1]; i++) {
+                const Arc& arc = arcs[downArcs[i]];
+                double dx = du + arc.weight;
+                if (dx < bwd.getDist(arc.from)) {
+                    bwd.setDist(arc.from, dx);
+                    bwd.setPre(arc.from, u);
+                    qb.push(arc.from, dx);
+                }
+            }
+        }
+    }
+    qf.clear();
+    qb.clear();
+    return meet;
+}
+
+//=================================================================
+// upwardSearch
+// Dijkstra over upward arcs only, run to exhaustion: forward from s
+//   over arcs toward higher rank, or backward from s over arcs
+//   coming from higher rank
+// Parameters:  s - index of the start vertex
+//              forward - direction of the search
+//              ctx - context for the search
+//              reached - set to every settled vertex with its distance
+// Returns:     none
+//=================================================================
+template <class K, class D>
+void ContractionHierarchy<K,D>::upwardSearch ( uint32_t s, bool forward, SearchContext& ctx, vector<pair<uint32_t, double>>& reached ) const
+{
+    const vector<uint32_t>& offsets = forward ? upOffsets : downOffsets;
+    const vector<uint32_t>& list = forward ? upArcs : downArcs;
+    ctx.reset(numVertices(), s);
+    ctx.setDist(s, 0);
+    IndexedHeap<double>& q = ctx.heap();
+    q.clear();
+    q.push(s, 0);
+    reached.clear();
+    while (!q.empty()) {
+        uint32_t u = q.pop();
+        double du = ctx.getDist(u);
+        ctx.setSettled(u);
+        reached.push_back(make_pair(u, du));
+        for (uint32_t i = offsets[u]; i < offsets[u + 1]; i++) {
+            const Arc& arc = arcs[list[i]];
+            uint32_t v = forward ? arc.to : arc.from;
+            double dv = du + arc.weight;
+            if (dv < ctx.getDist(v)) {
+                ctx.setDist(v, dv);
+                ctx.setPre(v, u);
+                q.push(v, dv);
+            }
+        }
+    }
+}
+
+//=================================================================
+// upArcTo
+// Finds the shortest upward arc from u to w
+// Parameters:  u - index of the lower vertex
+//              w - index of the higher vertex
+// Returns:     id of the arc
+//=================================================================
+template <class K, class D>
+uint32_t ContractionHierarchy<K,D>::upArcTo ( uint32_t u, uint32_t w ) const
+{
+    uint32_t found = NO_VERTEX;
+    for (uint32_t i = upOffsets[u]; i < upOffsets[u + 1]; i++) {
+        uint32_t a = upArcs[i];
+        if (arcs[a].to == w && (found == NO_VERTEX || arcs[a].weight < arcs[found].weight))
+            found = a;
+    }
+    return found;
+}
+
+//=================================================================
+// downArcFrom
+// Finds the shortest arc from the higher vertex x down to u
+// Parameters:  u - index of the lower vertex
+//              x - index of the higher vertex
+// Returns:     id of the arc
+//=================================================================
+template <class K, class D>
+uint32_t ContractionHierarchy<K,D>::downArcFrom ( uint32_t u, uint32_t x ) const
+{
+    uint32_t found = NO_VERTEX;
+    for (uint32_t i = downOffsets[u]; i < downOffsets[u + 1]; i++) {
+        uint32_t a = downArcs[i];
+        if (arcs[a].from == x && (found == NO_VERTEX || arcs[a].weight < arcs[found].weight))
+            found = a;
+    }
+    return found;
+}
+
+//=================================================================
+// unpack
+// Replaces an arc by the original edges it stands for
+// Parameters:  arc - id of the arc
+//              edges - the edge positions in base are appended here
+// Returns:     none
+//=================================================================
+template <class K, class D>
+void ContractionHierarchy<K,D>::unpack ( uint32_t arc, vector<uint32_t>& edges ) const
+{
+    vector<uint32_t> pending(1, arc);
+    while (!pending.empty()) {
+        const Arc& a = arcs[pending.back()];
+        pending.pop_back();
+        if (a.second == NO_VERTEX) {
+            edges.push_back(a.first);
+        } else {
+            pending.push_back(a.second);
+            pending.push_back(a.first);
+        }
+    }
+}
+
+//=================================================================
+// distance
+// Returns the shortest weighted distance between two vertices using
+//   the calling thread's search contexts
+// Parameters:  s - source vertex key
+//              d - destination vertex key
+// Returns:     the distance, infinity if d is unreachable from s
+//=================================================================
+template <class K, class D>
+double ContractionHierarchy<K,D>::distance ( K s, K d ) const
+{
+    return distance(s, d, SearchContext::local(0), SearchContext::local(1));
+}
+
+//=================================================================
+// distance
+// Same as above with explicit contexts for the two searches
+// Parameters:  s - source vertex key
+//              d - destination vertex key
+//              fwd - context for the forward search
+//              bwd - context for the backward search
+// Returns:     the distance, infinity if d is unreachable from s
+//=================================================================
+template <class K, class D>
+double ContractionHierarchy<K,D>::distance ( K s, K d, SearchContext& fwd, SearchContext& bwd ) const
+{
+    uint32_t src = base.indexOf(s);
+    uint32_t dst = base.indexOf(d);
+    if (src == NO_VERTEX || dst == NO_VERTEX)
+        throw invalid_argument("Error in distance: One or both vertices not found.");
+
+    uint32_t meet = query(src, dst, fwd, bwd);
+    return meet == NO_VERTEX ? SearchContext::INF : fwd.getDist(meet) + bwd.getDist(meet);
+}
+
+//=================================================================
+// distanceTable
+// Shortest weighted distances from each source to each target with
+//   the bucket method. An upward search back from each target drops
+//   (target, distance) into a bucket at every vertex it settles; an
+//   upward search from each source then reads the buckets of the
+//   vertices it settles. Both phases run one search per key on the
+//   threads of a pool.
+// Parameters:  sources - source vertex keys, one row each
+//              targets - target vertex keys, one column each
+//              threads - number of threads, 0 for one per core
+// Returns:     sources.size() x targets.size() matrix of distances,
+//              SearchContext::INF where a target cannot be reached
+// Throws:      invalid_argument if a vertex is not found
+//=================================================================
+template <class K, class D>
+Matrix<double> ContractionHierarchy<K,D>::distanceTable ( const vector<K>& sources, const vector<K>& targets, unsigned threads ) const
+{
+    ThreadPool pool(threads > 0 ? threads : thread::hardware_concurrency());
+    return distanceTable(sources, targets, pool);
+}
+
+//=================================================================
+// distanceTable
+// Same as above on the threads of a pool
+// Parameters:  sources - source vertex keys, one row each
+//              targets - target vertex keys, one column each
+//              pool - threads to run on
+// Returns:     sources.size() x targets.size() matrix of distances
+// Throws:      invalid_argument if a vertex is not found
+//=================================================================
+template <class K, class D>
+Matrix<double> ContractionHierarchy<K,D>::distanceTable ( const vector<K>& sources, const vector<K>& targets, ThreadPool& pool ) const
+{
+    vector<uint32_t> from(sources.size());
+    vector<uint32_t> to(targets.size());
+    for (size_t i = 0; i < sources.size(); i++)
+        from[i] = base.indexOf(sources[i]);
+    for (size_t j = 0; j < targets.size(); j++)
+        to[j] = base.indexOf(targets[j]);
+    if (find(from.begin(), from.end(), NO_VERTEX) != from.end() || find(to.begin(), to.end(), NO_VERTEX) != to.end())
+        throw invalid_argument("Error in distanceTable: Vertex not found.");
+
+    // backward searches, then their results grouped into buckets by vertex
+    vector<vector<pair<uint32_t, double>>> reached(to.size());
+    pool.parallelFor(to.size(), [&](size_t begin, size_t end, unsigned) {
+        SearchContext& ctx = SearchContext::local(1);
+        for (size_t j = begin; j < end; j++)
+            upwardSearch(to[j], false, ctx, reached[j]);
+    }, 1);
+    vector<uint32_t> bucketStart(numVertices() + 1, 0);
+    for (const auto& list : reached) {
+        for (const auto& entry : list)
+            bucketStart[entry.first + 1]++;
+    }
+    for (uint32_t v = 0; v < numVertices(); v++)
+        bucketStart[v + 1] += bucketStart[v];
+    vector<pair<uint32_t, double>> buckets(bucketStart.back());   // (column, distance to target)
+    vector<uint32_t> fill(bucketStart.begin(), bucketStart.end() - 1);
+    for (uint32_t j = 0; j < reached.size(); j++) {
+        for (const auto& entry : reached[j])
+            buckets[fill[entry.first]++] = make_pair(j, entry.second);
+        vector<pair<uint32_t, double>>().swap(reached[j]);
+    }
+
+    // forward searches, each filling its own row
+    Matrix<double> table(from.size(), to.size(), SearchContext::INF);
+    pool.parallelFor(from.size(), [&](size_t begin, size_t end, unsigned) {
+        SearchContext& ctx = SearchContext::local(0);
+        vector<pair<uint32_t, double>> up;
+        for (size_t i = begin; i < end; i++) {
+            upwardSearch(from[i], true, ctx, up);
+            double* row = table.row(i);
+            for (const auto& entry : up) {
+                for (uint32_t b = bucketStart[entry.first]; b < bucketStart[entry.first + 1]; b++)
+                    row[buckets[b].first] = min(row[buckets[b].first], entry.second + buckets[b].second);
+            }
+        }
+    }, 1);
+    return table;
+}
+
+//=================================================================
+// shortestPath
+// Finds the shortest weighted path between two vertices using the
+//   calling thread's search contexts
+// Parameters:  s - source vertex key
+//              d - destination vertex key
+// Returns:     string representation of the shortest path
+//=================================================================
+template <class K, class D>
+string ContractionHierarchy<K,D>::shortestPath ( K s, K d ) const
+{
+    return shortestPath(s, d, SearchContext::local(0), SearchContext::local(1));
+}
+
+//=================================================================
+// shortestPath
+// Finds the shortest weighted path between two vertices. Shortcuts
+//   are unpacked into the original edges, so the result is the same
+//   as Graph::shortestPath(s, d, true).
+// Parameters:  s - source vertex key
+//              d - destination vertex key
+//              fwd - context for the forward search
+//              bwd - context for the backward search
+// Returns:     string representation of the shortest path
+//=================================================================
+template <class K, class D>
+string ContractionHierarchy<K,D>::shortestPath ( K s, K d, SearchContext& fwd, SearchContext& bwd ) const
+{
+    if (base.indexOf(s) == NO_VERTEX || base.indexOf(d) == NO_VERTEX)
+        return "Either one or both of your input keys don't exist as a vertex.";
+    return formatPathText(base, findPath(s, d, fwd, bwd));
+}
+
+//=================================================================
+// findPath
+// Finds the shortest weighted path between two vertices using the
+//   calling thread's search contexts
+// Parameters:  s - source vertex key
+//              d - destination vertex key
+// Returns:     the path in the original graph, empty if d cannot be
+//              reached
+// Throws:      invalid_argument if either vertex is not found
+//=================================================================
+template <class K, class D>
+Path ContractionHierarchy<K,D>::findPath ( K s, K d ) const
+{
+    return findPath(s, d, SearchContext::local(0), SearchContext::local(1));
+}
+
+//=================================================================
+// findPath
+// Same as above with explicit contexts for the two searches.
+//   Shortcuts are unpacked into the original edges.
+// Parameters:  s - source vertex key
+//              d - destination vertex key
+//              fwd - context for the forward search
+//              bwd - context for the backward search
+// Returns:     the path in the original graph, empty if d cannot be
+//              reached
+// Throws:      invalid_argument if either vertex is not found
+//=================================================================
+template <class K, class D>
+Path ContractionHierarchy<K,D>::findPath ( K s, K d, SearchContext& fwd, SearchContext& bwd ) const
+{
+    uint32_t src = base.indexOf(s);
+    uint32_t dst = base.indexOf(d);
+    if (src == NO_VERTEX || dst == NO_VERTEX)
+        throw invalid_argument("Error in findPath: One or both vertices not found.");
+
+    uint32_t meet = query(src, dst, fwd, bwd);
+    if (meet == NO_VERTEX)
+        return Path();
+
+    // arcs up from s to meet, then down from meet to t
+    vector<uint32_t> path;
+    for (uint32_t v = meet; v != src; v = fwd.getPre(v))
+        path.push_back(upArcTo(fwd.getPre(v), v));
+    reverse(path.begin(), path.end());
+    for (uint32_t x = meet; x != dst; x = bwd.getPre(x))
+        path.push_back(downArcFrom(bwd.getPre(x), x));
+
+    vector<uint32_t> edges;
+    for (uint32_t arc : path)
+        unpack(arc, edges);
+
+    Path result;
+    result.vertices.push_back(src);
+    result.distances.push_back(0);
+    for (uint32_t edge : edges) {
+        uint32_t u = result.vertices.back();
+        result.vertices.push_back(base.targets[edge]);
+        result.edges.push_back(edge - base.offsets[u]);
+        result.distances.push_back(result.distances.back() + base.weights[edge]);
+    }
+    return result;
+}
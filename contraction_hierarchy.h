@@ -0,0 +1,78 @@
+//=================================================================
+// CS 271 - Project 6
+// contraction_hierarchy.h
+// Fall 2025
+// This is the declaration file for the ContractionHierarchy class,
+// a preprocessed index for fast point-to-point shortest paths
+//=================================================================
+
+#ifndef CONTRACTION_HIERARCHY_H
+#define CONTRACTION_HIERARCHY_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "graph.h"
+#include "compact_graph.h"
+#include "search_context.h"
+using namespace std;
+
+// Vertices are contracted one at a time in order of edge difference.
+// Contracting v removes it from the remaining graph and adds a
+// shortcut u -> w for every path u -> v -> w that has no equally
+// short witness path avoiding v. A query then only has to search
+// upward (toward later contracted vertices) from both ends.
+template <class K, class D>
+class ContractionHierarchy
+{
+private:
+   // an original edge (second == NO_VERTEX, first is its position in
+   // base) or a shortcut made of the arcs first and second
+   struct Arc
+   {
+       uint32_t from;
+       uint32_t to;
+       double   weight;
+       uint32_t first;
+       uint32_t second;
+   };
+
+   static constexpr uint32_t WITNESS_LIMIT = 500;  // vertices settled per witness search
+
+   CompactGraph<K,D>   base;        // original graph, used to unpack paths
+   vector<uint32_t>    rank;        // vertex index -> contraction order
+   vector<Arc>         arcs;        // original edges and shortcuts
+   vector<uint32_t>    upOffsets;   // numV + 1 entries
+   vector<uint32_t>    upArcs;      // arcs u -> w with rank[w] > rank[u], grouped by u
+   vector<uint32_t>    downOffsets; // numV + 1 entries
+   vector<uint32_t>    downArcs;    // arcs x -> u with rank[x] > rank[u], grouped by u
+   uint32_t            shortcuts;   // number of shortcut arcs kept
+
+   void     build          ( );
+   void     findShortcuts  ( uint32_t v, const vector<vector<uint32_t>>& out, const vector<vector<uint32_t>>& in,
+                             SearchContext& witness, vector<pair<uint32_t, uint32_t>>& needed ) const;
+   uint32_t addArc         ( uint32_t from, uint32_t to, double weight, uint32_t first, uint32_t second );
+   uint32_t upArcTo        ( uint32_t u, uint32_t w ) const;
+   uint32_t downArcFrom    ( uint32_t u, uint32_t x ) const;
+   uint32_t query          ( uint32_t s, uint32_t t, SearchContext& fwd, SearchContext& bwd ) const;
+   void     upwardSearch   ( uint32_t s, bool forward, SearchContext& ctx, vector<pair<uint32_t, double>>& reached ) const;
+   void     unpack         ( uint32_t arc, vector<uint32_t>& edges ) const;
+public:
+            ContractionHierarchy ( );
+            ContractionHierarchy ( const Graph<K,D>& g );
+            ContractionHierarchy ( const CompactGraph<K,D>& g );
+
+   uint32_t numVertices    ( ) const { return base.numVertices(); }
+   uint32_t numShortcuts   ( ) const { return shortcuts; }
+   uint32_t rankOf         ( K key ) const;
+   double   distance       ( K s, K d ) const;
+   double   distance       ( K s, K d, SearchContext& fwd, SearchContext& bwd ) const;
+   string   shortestPath   ( K s, K d ) const;
+   string   shortestPath   ( K s, K d, SearchContext& fwd, SearchContext& bwd ) const;
+   Matrix<double> distanceTable ( const vector<K>& sources, const vector<K>& targets, unsigned threads = 0 ) const;
+   Matrix<double> distanceTable ( const vector<K>& sources, const vector<K>& targets, ThreadPool& pool ) const;
+   Path     findPath       ( K s, K d ) const;
+   Path     findPath       ( K s, K d, SearchContext& fwd, SearchContext& bwd ) const;
+};
+#include "contraction_hierarchy.cpp"
+#endif
@@ -0,0 +1,182 @@
+//=================================================================
+// CS 271 - Project 6
+// floyd_warshall.cpp
+// Fall 2025
+// This is the implementation file for the blocked Floyd-Warshall
+// all-pairs shortest path routines
+//=================================================================
+
+#include <algorithm>
+#include <climits>
+#include <limits>
+#include <stdexcept>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FW_HAVE_AVX2_PATH 1
+#endif
+
+
+//=================================================================
+// minPlusRow
+// out[j] = min(out[j], a + in[j]) for j in [0, n)
+// Parameters:  out - row being improved
+//              in - row of the intermediate vertex
+//              a - distance to the intermediate vertex
+//              n - number of entries
+// Returns:     none
+//=================================================================
+inline void minPlusRow ( double* out, const double* in, double a, size_t n )
+{
+    for (size_t j = 0; j < n; j++)
+        out[j] = min(out[j], a + in[j]);
+}
+
+inline void minPlusRow ( int* out, const int* in, int a, size_t n )
+{
+    for (size_t j = 0; j < n; j++) {
+        uint32_t sum = uint32_t(a) + uint32_t(in[j]);
+        if (sum < uint32_t(out[j]))
+            out[j] = sum;
+    }
+}
+
+#ifdef FW_HAVE_AVX2_PATH
+//=================================================================
+// minPlusRowAVX2
+// minPlusRow four doubles or eight ints at a time
+//=================================================================
+__attribute__((target("avx2")))
+inline void minPlusRowAVX2 ( double* out, const double* in, double a, size_t n )
+{
+    __m256d va = _mm256_set1_pd(a);
+    size_t j = 0;
+    for (; j + 4 <= n; j += 4) {
+        __m256d sum = _mm256_add_pd(va, _mm256_loadu_pd(in + j));
+        _mm256_storeu_pd(out + j, _mm256_min_pd(_mm256_loadu_pd(out + j), sum));
+    }
+    minPlusRow(out + j, in + j, a, n - j);
+}
+
+__attribute__((target("avx2")))
+inline void minPlusRowAVX2 ( int* out, const int* in, int a, size_t n )
+{
+    __m256i va = _mm256_set1_epi32(a);
+    size_t j = 0;
+    for (; j + 8 <= n; j += 8) {
+        // a and in[j] are in [0, INT_MAX], so their sum fits as unsigned
+        __m256i sum = _mm256_add_epi32(va, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + j)));
+        __m256i* cell = reinterpret_cast<__m256i*>(out + j);
+        _mm256_storeu_si256(cell, _mm256_min_epu32(_mm256_loadu_si256(cell), sum));
+    }
+    minPlusRow(out + j, in + j, a, n - j);
+}
+#endif
+
+//=================================================================
+// relaxTile
+// Runs the k steps of one block on one tile:
+//   dist[i][j] = min(dist[i][j], dist[i][k] + dist[k][j])
+// Parameters:  dist - the matrix
+//              ti, tj - tile row and column
+//              tk - block of intermediate vertices
+//              simd - use the AVX2 loop
+// Returns:     none
+//=================================================================
+template <class T>
+void relaxTile ( Matrix<T>& dist, uint32_t ti, uint32_t tj, uint32_t tk, bool simd )
+{
+    const T INF = numeric_limits<T>::has_infinity ? numeric_limits<T>::infinity() : numeric_limits<T>::max();
+    uint32_t n = dist.rows();
+    uint32_t i1 = min(n, (ti + 1) * FW_TILE);
+    uint32_t j0 = tj * FW_TILE;
+    uint32_t width = min(n, j0 + FW_TILE) - j0;
+    uint32_t k1 = min(n, (tk + 1) * FW_TILE);
+    for (uint32_t k = tk * FW_TILE; k < k1; k++) {
+        const T* through = dist.row(k) + j0;
+        for (uint32_t i = ti * FW_TILE; i < i1; i++) {
+            T a = dist(i, k);
+            if (a == INF)
+                continue;
+#ifdef FW_HAVE_AVX2_PATH
+            if (simd) {
+                minPlusRowAVX2(dist.row(i) + j0, through, a, width);
+                continue;
+            }
+#endif
+            minPlusRow(dist.row(i) + j0, through, a, width);
+        }
+    }
+}
+
+//=================================================================
+// blockedFloydWarshall
+// The tiled loop shared by both element types
+// Parameters:  dist - square weight matrix, replaced by distances
+//              pool - threads to run on
+// Returns:     none
+// Throws:      invalid_argument if dist is not square
+//=================================================================
+template <class T>
+void blockedFloydWarshall ( Matrix<T>& dist, ThreadPool& pool )
+{
+    if (dist.rows() != dist.cols())
+        throw invalid_argument("Error in floydWarshall: Matrix is not square.");
+#ifdef FW_HAVE_AVX2_PATH
+    bool simd = __builtin_cpu_supports("avx2");
+#else
+    bool simd = false;
+#endif
+    uint32_t tiles = (dist.rows() + FW_TILE - 1) / FW_TILE;
+    for (uint32_t tk = 0; tk < tiles; tk++) {
+        relaxTile(dist, tk, tk, tk, simd);
+
+        // row and column of the diagonal tile: entry t < tiles is (tk, t), the rest (t', tk)
+        pool.parallelFor(2 * tiles, [&](size_t begin, size_t end, unsigned) {
+            for (size_t t = begin; t < end; t++) {
+                uint32_t other = t % tiles;
+                if (other == tk)
+                    continue;
+                if (t < tiles)
+                    relaxTile(dist, tk, other, tk, simd);
+                else
+                    relaxTile(dist, other, tk, tk, simd);
+            }
+        }, 1);
+
+        // everything else depends only on the row and column just done
+        pool.parallelFor(size_t(tiles) * tiles, [&](size_t begin, size_t end, unsigned) {
+            for (size_t t = begin; t < end; t++) {
+                uint32_t ti = t / tiles;
+                uint32_t tj = t % tiles;
+                if (ti != tk && tj != tk)
+                    relaxTile(dist, ti, tj, tk, simd);
+            }
+        }, 1);
+    }
+}
+
+//=================================================================
+// floydWarshall
+// All-pairs shortest paths of a weight matrix, in place
+// Parameters:  dist - square weight matrix, replaced by distances
+//              pool - threads to run on
+// Returns:     none
+// Throws:      invalid_argument if dist is not square
+//=================================================================
+inline void floydWarshall ( Matrix<double>& dist, ThreadPool& pool )
+{
+    blockedFloydWarshall(dist, pool);
+}
+
+//=================================================================
+// floydWarshall
+// Same as above with INT_MAX for no path and non-negative weights
+// Parameters:  dist - square weight matrix, replaced by distances
+//              pool - threads to run on
+// Returns:     none
+// Throws:      invalid_argument if dist is not square
+//=================================================================
+inline void floydWarshall ( Matrix<int>& dist, ThreadPool& pool )
+{
+    blockedFloydWarshall(dist, pool);
+}
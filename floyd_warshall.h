@@ -0,0 +1,37 @@
+//=================================================================
+// CS 271 - Project 6
+// floyd_warshall.h
+// Fall 2025
+// This is the declaration file for the blocked Floyd-Warshall
+// all-pairs shortest path routines
+//=================================================================
+
+#ifndef FLOYD_WARSHALL_H
+#define FLOYD_WARSHALL_H
+
+#include <cstdint>
+#include "matrix.h"
+#include "thread_pool.h"
+using namespace std;
+
+// Each turns a square matrix of edge weights (cell (i, j) the weight
+// of edge i -> j, "infinity" where there is none) into the matrix of
+// shortest path lengths, in place. The matrix is processed in tiles
+// of FW_TILE x FW_TILE so the three tiles a step touches stay in
+// cache; for each block of k, the diagonal tile is done first, then
+// the tiles in its row and column, then all others, the tiles of each
+// phase in parallel. The inner min-plus loop uses AVX2 when the CPU
+// has it.
+//
+// double: infinity is SearchContext::INF (or any +inf); weights may
+//   be negative as long as there is no negative cycle.
+// int:    infinity is INT_MAX, as in Graph::asAdjMatrix; weights must
+//   be non-negative. Sums are formed as unsigned, so INT_MAX plus a
+//   weight never overflows and never wins a min.
+const uint32_t FW_TILE = 64;
+
+void     floydWarshall  ( Matrix<double>& dist, ThreadPool& pool );
+void     floydWarshall  ( Matrix<int>& dist, ThreadPool& pool );
+
+#include "floyd_warshall.cpp"
+#endif
@@ -11,6 +11,9 @@
 #include <stack>
 #include <vector>
 #include <set>
+#include <algorithm>
+#include <sstream>
+#include <atomic>
 
 
 //=================================================================
@@ -20,46 +23,140 @@
 // Returns:     none
 //=================================================================
 template <class K, class D>
-Graph<K,D>::Graph ( )
+Graph<K,D>::Graph ( ) : Graph(GraphStorage::Pool)
 {
+}
+
+//=================================================================
+// Constructor
+// Creates an empty graph that allocates its adjacency lists as kind
+//   says (see GraphStorage)
+// Parameters:  kind - pool or arena
+//              upstream - where the pool or arena gets its memory
+// Returns:     none
+//=================================================================
+template <class K, class D>
+Graph<K,D>::Graph ( GraphStorage kind, pmr::memory_resource* upstream )
+{
+    if (kind == GraphStorage::Arena)
+        storage.reset(new pmr::monotonic_buffer_resource(upstream));
+    else
+        storage.reset(new pmr::unsynchronized_pool_resource(upstream));
+    storageKind = kind;
+    this->upstream = upstream;
     numV = 0;
     numE = 0;
+    astarScale = SearchContext::INF;
 }
 
 //=================================================================
 // Constructor
-// Creates a graph with given vertices and edges
+// Creates a graph with given vertices and edges. The edges are
+//   grouped and deduplicated on several threads (see insertEdges),
+//   so large edge lists build in time linear in their size.
 // Parameters:  keys - vector of vertex keys
-//              data - vector of vertex data
-//              edges - vector of edges as tuples(vertex1, vertex2, weight)
+//              data - vector of vertex data (longitude, latitude)
+//              edges - vector of edges as tuples(vertex1, vertex2, weight, label)
+//              threads - number of threads, 0 for one per core
+//              kind - how to allocate the adjacency lists
 // Returns:     none
+// Throws:      invalid_argument if an edge names a missing vertex
 //=================================================================
 template <class K, class D>
-Graph<K,D>::Graph ( vector<K> keys, vector<D> data, vector<tuple<K,K,int>> edges )
+Graph<K,D>::Graph ( const vector<K>& keys, const vector<tuple<double, double>>& data,
+                    const vector<tuple<K, K, double, string>>& edges, unsigned threads,
+                    GraphStorage kind ) : Graph(kind)
 {
-    numV = 0;
-    numE = 0;
-    for (int i = 0; i < keys.size(); i++)
+    reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); i++)
         insertVertex(keys[i], data[i]);
-    for (int j = 0; j < edges.size(); j++)
-    {
-        K v1 = get<0>(edges[j]);
-        K v2 = get<1>(edges[j]);
-        int w = get<2>(edges[j]);
-        string label = get<3>(edges[j]);
-        insertEdge(v1, v2, w, label);
-    }
+    ThreadPool pool(threads > 0 ? threads : thread::hardware_concurrency());
+    insertEdges(edges, pool);
 }
 
 //=================================================================
 // Destructor
-// Destroys the graph
+// Destroys the graph. The adjacency lists are not freed one by one:
+//   destroying storage frees them all.
 // Parameters:  none
 // Returns:     none
 //=================================================================
 template <class K, class D>
 Graph<K,D>::~Graph ( ) {}
 
+//=================================================================
+// Copy constructor
+// Copies a graph into storage of its own, of the same kind
+// Parameters:  other - the graph to copy
+// Returns:     none
+//=================================================================
+template <class K, class D>
+Graph<K,D>::Graph ( const Graph& other ) : Graph(other.storageKind, other.upstream)
+{
+    numV = other.numV;
+    numE = other.numE;
+    vertices.resize(other.vertices.size());
+    for (size_t u = 0; u < vertices.size(); u++) {
+        vertices[u].data = other.vertices[u].data;
+        vertices[u].key = other.vertices[u].key;
+        vertices[u].adj.assign(other.vertices[u].adj.begin(), other.vertices[u].adj.end(), storage.get());
+        vertices[u].radj.assign(other.vertices[u].radj.begin(), other.vertices[u].radj.end(), storage.get());
+    }
+    index = other.index;
+    labels = other.labels;
+    search = other.search;
+    astarScale = other.astarScale;
+    spatial = atomic_load(&other.spatial);
+}
+
+//=================================================================
+// Move constructor
+// Takes over a graph and its storage, leaving it empty
+// Parameters:  other - the graph to move from
+// Returns:     none
+//=================================================================
+template <class K, class D>
+Graph<K,D>::Graph ( Graph&& other ) : Graph(other.storageKind, other.upstream)
+{
+    swap(other);
+}
+
+//=================================================================
+// Assignment operator
+// Copies or moves a graph (other is a copy or was moved into)
+// Parameters:  other - the graph to take over
+// Returns:     this graph
+//=================================================================
+template <class K, class D>
+Graph<K,D>& Graph<K,D>::operator= ( Graph other )
+{
+    swap(other);
+    return *this;
+}
+
+//=================================================================
+// swap
+// Exchanges two graphs. The adjacency lists stay with the storage
+//   they were allocated from.
+// Parameters:  other - the other graph
+// Returns:     none
+//=================================================================
+template <class K, class D>
+void Graph<K,D>::swap ( Graph& other )
+{
+    std::swap(storage, other.storage);
+    std::swap(storageKind, other.storageKind);
+    std::swap(upstream, other.upstream);
+    std::swap(numV, other.numV);
+    std::swap(numE, other.numE);
+    std::swap(vertices, other.vertices);
+    std::swap(index, other.index);
+    std::swap(labels, other.labels);
+    std::swap(search, other.search);
+    std::swap(astarScale, other.astarScale);
+    std::swap(spatial, other.spatial);
+}
+
 //=================================================================
 // isEdge
 // Checks if there is an edge between two vertices
@@ -69,13 +166,15 @@ Graph<K,D>::~Graph ( ) {}
 //=================================================================
 template <class K, class D>
 bool Graph<K,D>::isEdge ( K v1, K v2 ) const{
-    if (vertices.find(v1) == vertices.end() || vertices.find(v2) == vertices.end())
+    uint32_t u = index.find(v1);
+    uint32_t v = index.find(v2);
+    if (u == NO_VERTEX || v == NO_VERTEX)
         throw invalid_argument("Error in isEdge: One or both vertices not found.");
     // get the adjacency list of v1
-    const list<tuple<K, int>>& adj = vertices.at(v1).adj;
+    const auto& adj = vertices[u].adj;
     // check if v2 is in the adjacency list
     for (const auto& edge : adj) {
-        if (get<0>(edge) == v2)
+        if (edge.target == v)
             return true;
     }
     return false;
@@ -89,14 +188,15 @@ bool Graph<K,D>::isEdge ( K v1, K v2 ) const{
 // Returns:     weight of the edge if it exists, INT_MAX otherwise
 //=================================================================
 template <class K, class D>
-int Graph<K,D>::getWeight ( K v1, K v2 ) const {
+double Graph<K,D>::getWeight ( K v1, K v2 ) const {
     if (!isEdge(v1, v2))
         return INT_MAX;
     // get the adjacency list of v1
-    const list<tuple<K, int>>& adj = vertices[v1].adj;
+    const auto& adj = vertices[index.find(v1)].adj;
+    uint32_t v = index.find(v2);
     for (const auto& edge : adj) {
-        if (get<0>(edge) == v2) // first element in tuple is the adjacent vertex key
-            return get<1>(edge); // second element is the weight
+        if (edge.target == v)
+            return edge.weight;
     }
     return INT_MAX;
 }
@@ -107,29 +207,344 @@ int Graph<K,D>::getWeight ( K v1, K v2 ) const {
 // Parameters:  v1 - key of the first vertex
 //              v2 - key of the second vertex
 //              w  - weight of the edge
+//              label - name of the edge, stored once per distinct name
 // Returns:     none
 //=================================================================
 template <class K, class D>
-void Graph<K,D>::insertEdge ( K v1, K v2, int w, string label)
+void Graph<K,D>::insertEdge ( K v1, K v2, double w, const string& label )
 {
-    if (vertices.find(v1) == vertices.end() || vertices.find(v2) == vertices.end())
+    uint32_t u = index.find(v1);
+    uint32_t v = index.find(v2);
+    if (u == NO_VERTEX || v == NO_VERTEX)
         throw invalid_argument("Error in insertEdge: One or both vertices not found.");
         
+    // keep the A* estimate below this edge's weight; a raised weight
+    // leaves the old (smaller) scale in place, which is still safe
+    noteEdgeForHeuristic(u, v, w);
+
     // if edge already exists, update weight
-    for (auto& edge : vertices[v1].adj) {
-        if (get<0>(edge) == v2) {
-            edge = make_tuple(v2, w, label);
+    uint32_t id = labels.intern(label);
+    for (auto& edge : vertices[u].adj) {
+        if (edge.target == v) {
+            edge.weight = w;
+            edge.label = id;
+            for (auto& back : vertices[v].radj) {
+                if (back.source == u)
+                    back.weight = w;
+            }
             return;
         }
     }
-    // otherwise, add new edge to adjacency list
-    vertices[v1].adj.push_back(make_tuple(v2, w, label));
+    // otherwise, add new edge to adjacency list (and v's reverse list)
+    vertices[u].adj.push_back(AdjEdge{v, id, w}, storage.get());
+    vertices[v].radj.push_back(InEdge{u, w}, storage.get());
     numE++;
 }
 
+//=================================================================
+// insertEdges
+// Inserts many edges at once. The result is the same as calling
+//   insertEdge on each in order (a repeated edge keeps its first
+//   position and takes the last weight and label), but duplicates
+//   are found through a per-target table instead of by rescanning
+//   the adjacency list, so this is O(V + E).
+// Parameters:  edges - (from key, to key, weight, label) in order
+// Returns:     none
+//=================================================================
+template <class K, class D>
+void Graph<K,D>::insertEdges ( const vector<tuple<K, K, double, string>>& edges )
+{
+    uint32_t n = vertices.size();
+
+    // resolve keys and group the edges by source, keeping input order
+    vector<uint32_t> from(edges.size());
+    vector<uint32_t> to(edges.size());
+    vector<uint32_t> start(n + 1, 0);
+    for (size_t i = 0; i < edges.size(); i++) {
+        from[i] = index.find(get<0>(edges[i]));
+        to[i] = index.find(get<1>(edges[i]));
+        if (from[i] == NO_VERTEX || to[i] == NO_VERTEX)
+            throw invalid_argument("Error in insertEdges: One or both vertices not found.");
+        noteEdgeForHeuristic(from[i], to[i], get<2>(edges[i]));
+        start[from[i] + 1]++;
+    }
+    for (uint32_t u = 0; u < n; u++)
+        start[u + 1] += start[u];
+    vector<uint32_t> bySource(edges.size());
+    vector<uint32_t> fill(start.begin(), start.end() - 1);
+    for (size_t i = 0; i < edges.size(); i++)
+        bySource[fill[from[i]]++] = i;
+
+    // owner[v] == u while source u is being filled means adj[slot[v]] is u's edge to v;
+    // older[v] == u means that edge was there before this call
+    vector<uint32_t> owner(n, NO_VERTEX);
+    vector<uint32_t> older(n, NO_VERTEX);
+    vector<uint32_t> slot(n);
+    vector<pair<uint32_t, uint32_t>> updated;
+    vector<uint32_t> created(edges.size());
+    vector<char> isNew(edges.size(), 0);
+    for (uint32_t u = 0; u < n; u++) {
+        if (start[u] == start[u + 1])
+            continue;
+        auto& adj = vertices[u].adj;
+        for (uint32_t k = 0; k < adj.size(); k++) {
+            owner[adj[k].target] = u;
+            older[adj[k].target] = u;
+            slot[adj[k].target] = k;
+        }
+        for (uint32_t j = start[u]; j < start[u + 1]; j++) {
+            uint32_t i = bySource[j];
+            uint32_t v = to[i];
+            uint32_t id = labels.intern(get<3>(edges[i]));
+            if (owner[v] == u) {
+                adj[slot[v]].weight = get<2>(edges[i]);
+                adj[slot[v]].label = id;
+                if (older[v] == u)
+                    updated.push_back(make_pair(u, v));
+                continue;
+            }
+            adj.push_back(AdjEdge{v, id, get<2>(edges[i])}, storage.get());
+            owner[v] = u;
+            slot[v] = adj.size() - 1;
+            created[i] = slot[v];
+            isNew[i] = 1;
+            numE++;
+        }
+    }
+
+    // edges that existed before this call keep their reverse entry; update its weight
+    for (const auto& edge : updated) {
+        for (auto& back : vertices[edge.second].radj) {
+            if (back.source == edge.first)
+                back.weight = getWeight(vertices[edge.first].key, vertices[edge.second].key);
+        }
+    }
+
+    // reverse entries in input order, as insertEdge would add them
+    for (size_t i = 0; i < edges.size(); i++) {
+        if (isNew[i])
+            vertices[to[i]].radj.push_back(InEdge{from[i], vertices[from[i]].adj[created[i]].weight}, storage.get());
+    }
+}
+
+//=================================================================
+// insertEdges
+// Same as above on the threads of a pool. Into a graph with no edges
+//   yet, the edges are bucketed by source, and each vertex's bucket
+//   is sorted by target, deduplicated and turned into its adjacency
+//   list on whichever thread claims it; reverse lists are filled the
+//   same way. A graph that already has edges takes the sequential
+//   path above.
+// Parameters:  edges - (from key, to key, weight, label) in order
+//              pool - threads to run on
+// Returns:     none
+// Throws:      invalid_argument if an edge names a missing vertex
+//=================================================================
+template <class K, class D>
+void Graph<K,D>::insertEdges ( const vector<tuple<K, K, double, string>>& edges, ThreadPool& pool )
+{
+    if (numE == 0)
+        buildEdges(edges, pool);
+    else
+        insertEdges(edges);
+}
+
+//=================================================================
+// buildEdges
+// Fills the empty adjacency lists from an edge list, with the same
+//   result as calling insertEdge on each edge in order
+// Parameters:  edges - (from key, to key, weight, label) in order
+//              pool - threads to run on
+// Returns:     none
+// Throws:      invalid_argument if an edge names a missing vertex
+//=================================================================
+template <class K, class D>
+void Graph<K,D>::buildEdges ( const vector<tuple<K, K, double, string>>& edges, ThreadPool& pool )
+{
+    // labels are interned in input order, as insertEdge would
+    vector<tuple<K, K, double, uint32_t>> labeled(edges.size());
+    for (size_t i = 0; i < edges.size(); i++)
+        labeled[i] = make_tuple(get<0>(edges[i]), get<1>(edges[i]), get<2>(edges[i]), labels.intern(get<3>(edges[i])));
+    buildEdges(labeled, pool);
+}
+
+//=================================================================
+// buildEdges
+// Same as above, for edges whose labels are already interned
+// Parameters:  edges - (from key, to key, weight, label id) in order
+//              pool - threads to run on
+// Returns:     none
+// Throws:      invalid_argument if an edge names a missing vertex
+//=================================================================
+template <class K, class D>
+void Graph<K,D>::buildEdges ( const vector<tuple<K, K, double, uint32_t>>& edges, ThreadPool& pool )
+{
+    uint32_t n = vertices.size();
+    size_t m = edges.size();
+
+    // resolve keys; each worker keeps its own bound on the A* scale
+    vector<uint32_t> from(m);
+    vector<uint32_t> to(m);
+    vector<double> limits(pool.size(), SearchContext::INF);
+    atomic<bool> missing(false);
+    pool.parallelFor(m, [&](size_t begin, size_t end, unsigned worker) {
+        for (size_t i = begin; i < end; i++) {
+            from[i] = index.find(get<0>(edges[i]));
+            to[i] = index.find(get<1>(edges[i]));
+            if (from[i] == NO_VERTEX || to[i] == NO_VERTEX)
+                missing = true;
+            else
+                limits[worker] = min(limits[worker], heuristicLimit(from[i], to[i], get<2>(edges[i])));
+        }
+    });
+    if (missing)
+        throw invalid_argument("Error in insertEdges: One or both vertices not found.");
+    for (double limit : limits)
+        astarScale = min(astarScale, limit);
+
+    // counting sort by source; each bucket stays in input order
+    vector<uint32_t> start(n + 1, 0);
+    for (size_t i = 0; i < m; i++)
+        start[from[i] + 1]++;
+    for (uint32_t u = 0; u < n; u++)
+        start[u + 1] += start[u];
+    vector<uint32_t> bucket(m);
+    vector<uint32_t> fill(start.begin(), start.end() - 1);
+    for (size_t i = 0; i < m; i++)
+        bucket[fill[from[i]]++] = i;
+
+    // per source: a stable sort by target puts repeats of an edge side
+    // by side; the first sets its position, the last its weight and
+    // label. Kept edges are written back to the front of the bucket as
+    // (first, last) input positions, ordered by first.
+    vector<uint32_t> first(m);
+    vector<uint32_t> kept(n);
+    pool.parallelFor(n, [&](size_t begin, size_t end, unsigned) {
+        vector<pair<uint32_t, uint32_t>> runs;
+        for (size_t u = begin; u < end; u++) {
+            uint32_t* b = bucket.data() + start[u];
+            uint32_t* e = bucket.data() + start[u + 1];
+            stable_sort(b, e, [&](uint32_t x, uint32_t y) { return to[x] < to[y]; });
+            runs.clear();
+            for (uint32_t* r = b; r != e; ) {
+                uint32_t* s = r;
+                while (r != e && to[*r] == to[*s])
+                    r++;
+                runs.push_back(make_pair(*s, r[-1]));
+            }
+            sort(runs.begin(), runs.end());
+            for (size_t k = 0; k < runs.size(); k++) {
+                first[start[u] + k] = runs[k].first;
+                b[k] = runs[k].second;
+            }
+            kept[u] = runs.size();
+        }
+    });
+
+    // reverse lists: counting sort of the kept edges by target, then
+    // each target's in-edges in order of first appearance.
+    // storage is not thread safe, so every list is sized on this thread
+    // and only filled on the workers.
+    vector<uint32_t> rstart(n + 1, 0);
+    for (uint32_t u = 0; u < n; u++) {
+        for (uint32_t j = start[u]; j < start[u] + kept[u]; j++)
+            rstart[to[bucket[j]] + 1]++;
+        numE += kept[u];
+        vertices[u].adj.reserve(kept[u], storage.get());
+    }
+    pool.parallelFor(n, [&](size_t begin, size_t end, unsigned) {
+        for (size_t u = begin; u < end; u++) {
+            for (uint32_t j = start[u]; j < start[u] + kept[u]; j++) {
+                uint32_t last = bucket[j];
+                vertices[u].adj.push_back(AdjEdge{to[last], get<3>(edges[last]), get<2>(edges[last])}, storage.get());
+            }
+        }
+    });
+    for (uint32_t v = 0; v < n; v++) {
+        rstart[v + 1] += rstart[v];
+        vertices[v].radj.reserve(rstart[v + 1] - rstart[v], storage.get());
+    }
+    vector<uint32_t> incoming(rstart[n]);
+    fill.assign(rstart.begin(), rstart.end() - 1);
+    for (uint32_t u = 0; u < n; u++) {
+        for (uint32_t j = start[u]; j < start[u] + kept[u]; j++)
+            incoming[fill[to[bucket[j]]]++] = j;
+    }
+    pool.parallelFor(n, [&](size_t begin, size_t end, unsigned) {
+        for (size_t v = begin; v < end; v++) {
+            uint32_t* b = incoming.data() + rstart[v];
+            uint32_t* e = incoming.data() + rstart[v + 1];
+            sort(b, e, [&](uint32_t x, uint32_t y) { return first[x] < first[y]; });
+            for (uint32_t* j = b; j != e; j++) {
+                uint32_t last = bucket[*j];
+                vertices[v].radj.push_back(InEdge{from[last], get<2>(edges[last])}, storage.get());
+            }
+        }
+    });
+}
+
+//=================================================================
+// reserve
+// Makes room for n vertices, so inserting up to n vertices does
+//   not reallocate the vertex storage or rehash the key index
+// Parameters:  n - expected number of vertices
+// Returns:     none
+//=================================================================
+template <class K, class D>
+void Graph<K,D>::reserve ( uint32_t n )
+{
+    vertices.reserve(n);
+    index.reserve(n);
+}
+
+//=================================================================
+// noteEdgeForHeuristic
+// Lowers the A* scale so that scale * (straight-line length) does
+//   not exceed the weight of edge u->v
+// Parameters:  u, v - vertex indices of the edge
+//              w - weight of the edge
+// Returns:     none
+//=================================================================
+template <class K, class D>
+void Graph<K,D>::noteEdgeForHeuristic ( uint32_t u, uint32_t v, double w )
+{
+    astarScale = min(astarScale, heuristicLimit(u, v, w));
+}
+
+//=================================================================
+// heuristicLimit
+// Largest A* scale that edge u->v allows
+// Parameters:  u, v - vertex indices of the edge
+//              w - weight of the edge
+// Returns:     the limit, INF if u and v are at the same point
+//=================================================================
+template <class K, class D>
+double Graph<K,D>::heuristicLimit ( uint32_t u, uint32_t v, double w ) const
+{
+    double length = haversineDistance(vertices[u].data, vertices[v].data);
+    if (length > 0) {
+        // shave off a little so rounding can never make the estimate too large
+        return max(0.0, w / length * (1 - 1e-9));
+    }
+    return SearchContext::INF;
+}
+
+//=================================================================
+// heuristicScale
+// Factor applied to straight-line distances by A*
+// Parameters:  none
+// Returns:     the scale, 0 if no edge constrains it
+//=================================================================
+template <class K, class D>
+double Graph<K,D>::heuristicScale ( ) const
+{
+    return astarScale == SearchContext::INF ? 0 : astarScale;
+}
+
 //=================================================================
 // insertVertex
-// Inserts a vertex with a given key and data
+// Inserts a vertex with a given key and data. New vertices get the
+//   next dense index (0, 1, 2, ... in insertion order).
 // Parameters:  key  - key of the vertex
 //              data - data associated with the vertex
 // Returns:     none
@@ -137,19 +552,76 @@ void Graph<K,D>::insertEdge ( K v1, K v2, int w, string label)
 template <class K, class D>
 void Graph<K,D>::insertVertex ( K key, tuple<double, double> data )
 {
-    if (vertices.find(key) != vertices.end()){
+    uint32_t u = index.insert(key, vertices.size());
+    spatial.reset();
+    if (u != vertices.size()){
         // vertex already exists, so just update data
-        vertices[key].data = data;
+        vertices[u].data = data;
+        // moving a vertex changes the length of its edges, so rebuild the A* scale
+        astarScale = SearchContext::INF;
+        for (uint32_t x = 0; x < vertices.size(); x++) {
+            for (const auto& edge : vertices[x].adj) {
+                noteEdgeForHeuristic(x, edge.target, edge.weight);
+            }
+        }
     }
     else {
         VertexInfo<K,D> newVertex;
         newVertex.data = data;
         newVertex.key = key;
-        vertices[key] = newVertex;
+        vertices.push_back(move(newVertex));
         numV++;
     }
 }
 
+//=================================================================
+// indexOf
+// Looks up the dense index of a vertex key
+// Parameters:  key - key of the vertex
+// Returns:     index of the vertex, NO_VERTEX if it does not exist
+//=================================================================
+template <class K, class D>
+uint32_t Graph<K,D>::indexOf ( K key ) const
+{
+    return index.find(key);
+}
+
+//=================================================================
+// keyOrder
+// Lists the vertex indices sorted by key, for output that is
+//   expected in key order
+// Parameters:  none
+// Returns:     vertex indices in increasing key order
+//=================================================================
+template <class K, class D>
+vector<uint32_t> Graph<K,D>::keyOrder ( ) const
+{
+    vector<uint32_t> order(vertices.size());
+    for (uint32_t i = 0; i < order.size(); i++)
+        order[i] = i;
+    sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+        return vertices[a].key < vertices[b].key;
+    });
+    return order;
+}
+
+//=================================================================
+// keyRanks
+// Position of each vertex in key order, the row and column it gets
+//   in the matrix exports
+// Parameters:  none
+// Returns:     rank of each vertex index
+//=================================================================
+template <class K, class D>
+vector<uint32_t> Graph<K,D>::keyRanks ( ) const
+{
+    vector<uint32_t> order = keyOrder();
+    vector<uint32_t> rank(order.size());
+    for (uint32_t i = 0; i < order.size(); i++)
+        rank[order[i]] = i;
+    return rank;
+}
+
 //=================================================================
 // toString
 // Represents the graph as a string, each line includes the 
@@ -161,10 +633,10 @@ template <class K, class D>
 string Graph<K,D>::toString ( ) const
 {
     stringstream ss;
-    for (const auto& pair : vertices) {
-        ss << pair.first << ": ";
-        for (const auto& edge : pair.second.adj) {
-            ss << "(" << get<0>(edge) << ", weight: " << get<1>(edge) << ") ";
+    for (uint32_t u : keyOrder()) {
+        ss << vertices[u].key << ": ";
+        for (const auto& edge : vertices[u].adj) {
+            ss << "(" << vertices[edge.target].key << ", weight: " << edge.weight << ") ";
         }
         ss << endl;
     }
@@ -172,87 +644,152 @@ string Graph<K,D>::toString ( ) const
 }
 
 //=================================================================
-// DFSVisit
-// Helper function for Depth-First Search
-// Parameters:  u - the current vertex
-//              time - the current time counter
+// DFS
+// Performs Depth-First Search on the graph, starting new trees
+//   in vertex index (insertion) order. The results are kept until
+//   the next search.
+// Parameters:  none
 // Returns:     none
 //=================================================================
 template <class K, class D>
-void Graph<K,D>::DFSVisit ( K u, int& time )
+void Graph<K,D>::DFS ( )
 {
-    time++;
-    vertices[u].d_time = time;
-    vertices[u].color = 'g';
-    for (const auto& edge : vertices[u].adj) {
-        K v = get<0>(edge);
-        if (vertices[v].color == 'w') {
-            vertices[v].pre = &u;
-            DFSVisit(v, time);
-        }
-    }
-    vertices[u].color = 'b';
-    time++;
-    vertices[u].f_time = time;
+    DFS(search);
 }
 
 //=================================================================
 // DFS
-// Performs Depth-First Search on the graph
-// Parameters:  none
+// Performs Depth-First Search without modifying the graph
+// Parameters:  ctx - receives colors, predecessors and times
 // Returns:     none
 //=================================================================
 template <class K, class D>
-void Graph<K,D>::DFS ( )
+void Graph<K,D>::DFS ( SearchContext& ctx ) const
 {
-    // set all vertices to initial state (white, no predecessor)
-    // in vertices map, .first is key, .second is VertexInfo
-    for (auto& u : vertices) {
-        u.second.color = 'w';
-        u.second.pre = nullptr;
-    }
-    int time = 0; // initialize time counter
-    // visit each vertex
-    for (auto& u : vertices) {
-        if (u.second.color == 'w') {
-            DFSVisit(u.first, time);
-        }
-    }
+    depthFirstSearch(*this, ctx);
+}
+
+//=================================================================
+// DFS
+// Performs Depth-First Search, reporting each discovery, finish and
+//   examined edge to the visitor as it happens (see DFSVisitor)
+// Parameters:  ctx - receives colors, predecessors and times
+//              visitor - receives the search events
+// Returns:     none
+//=================================================================
+template <class K, class D>
+template <class V>
+void Graph<K,D>::DFS ( SearchContext& ctx, V& visitor ) const
+{
+    depthFirstSearch(*this, ctx, visitor);
+}
+
+//=================================================================
+// topologicalOrder
+// Orders the vertex keys so that every edge points forward, using
+//   Kahn's algorithm in O(V+E). Vertices that do not depend on each
+//   other come out in index (insertion) order.
+// Parameters:  none
+// Returns:     keys in topological order
+// Throws:      invalid_argument naming a cycle if the graph is not a DAG
+//=================================================================
+template <class K, class D>
+vector<K> Graph<K,D>::topologicalOrder ( ) const
+{
+    vector<uint32_t> order;
+    vector<uint32_t> levels;
+    kahnTopologicalSort(*this, order, levels);
+    requireAcyclic(*this, order, "topologicalSort");
+
+    vector<K> keys;
+    keys.reserve(order.size());
+    for (uint32_t u : order)
+        keys.push_back(vertices[u].key);
+    return keys;
 }
 
 //=================================================================
 // topologicalSort
 // Returns a string representing the topological sort of the graph
-//  (keys in decreasing finishing time order)
 //   Main idea: visit each vertex only after all dependencies are
 //   complete (i.e., all vertices along path to it have been visited)
 //   Requires graph to be a DAG (Directed Acyclic Graph)
 // Parameters:  none
 // Returns:     string representation of the topological sort
+// Throws:      invalid_argument naming a cycle if the graph is not a DAG
 //=================================================================
 template <class K, class D>
-string Graph<K,D>::topologicalSort( )
+string Graph<K,D>::topologicalSort ( ) const
 {
-    DFS();
-
-    // get all the finishing times, store in a priority queue with respective keys
-    // priority determined by finishing time (max has highest priority)
-    priority_queue<pair<int, K>> finishTimes;
-    for (const auto& pair : vertices) {
-        finishTimes.push({pair.second.f_time, pair.first});
-    }
     // build the result string
     // only include "->" between keys, no trailing arrow
     stringstream ss;
-    while (!finishTimes.empty()) {
-        ss << finishTimes.top().second;
-        finishTimes.pop();
-        if (!finishTimes.empty()) {
+    bool first = true;
+    for (const K& key : topologicalOrder()) {
+        if (!first)
             ss << "->";
-        }
+        ss << key;
+        first = false;
     }
     return ss.str();
 }
+
+//=================================================================
+// topologicalLevels
+// Splits a topological order into wavefronts: the first holds the
+//   vertices without in-edges, and each later one the vertices whose
+//   last dependency is in the one before. Vertices in one wavefront
+//   are independent of each other and can be processed together.
+// Parameters:  none
+// Returns:     the wavefronts in order, each in index order
+// Throws:      invalid_argument naming a cycle if the graph is not a DAG
+//=================================================================
+template <class K, class D>
+vector<vector<K>> Graph<K,D>::topologicalLevels ( ) const
+{
+    vector<uint32_t> order;
+    vector<uint32_t> levels;
+    kahnTopologicalSort(*this, order, levels);
+    requireAcyclic(*this, order, "topologicalLevels");
+    return wavefronts(order, levels);
+}
+
+//=================================================================
+// topologicalLevels
+// Same as above, computing each wavefront on the threads of a pool
+// Parameters:  pool - threads to run on
+// Returns:     the wavefronts in order, each in index order
+// Throws:      invalid_argument naming a cycle if the graph is not a DAG
+//=================================================================
+template <class K, class D>
+vector<vector<K>> Graph<K,D>::topologicalLevels ( ThreadPool& pool ) const
+{
+    vector<uint32_t> order;
+    vector<uint32_t> levels;
+    parallelKahnTopologicalSort(*this, order, levels, pool);
+    requireAcyclic(*this, order, "topologicalLevels");
+    return wavefronts(order, levels);
+}
+
+//=================================================================
+// wavefronts
+// Turns a leveled order of vertex indices into lists of keys
+// Parameters:  order - vertex indices, wavefront by wavefront
+//              levels - start of each wavefront, then order.size()
+// Returns:     the keys of each wavefront
+//=================================================================
+template <class K, class D>
+vector<vector<K>> Graph<K,D>::wavefronts ( const vector<uint32_t>& order, const vector<uint32_t>& levels ) const
+{
+    vector<vector<K>> result(levels.size() - 1);
+    for (size_t l = 0; l + 1 < levels.size(); l++) {
+        result[l].reserve(levels[l + 1] - levels[l]);
+        for (uint32_t i = levels[l]; i < levels[l + 1]; i++)
+            result[l].push_back(vertices[order[i]].key);
+    }
+    return result;
+}
+
 //=================================================================
 // BFS
 // Performs Breadth-First Search starting from the given source vertex
@@ -262,36 +799,46 @@ string Graph<K,D>::topologicalSort( )
 template <class K, class D>
 void Graph<K,D>::BFS ( K source )
 {
-    for (auto& [_, vrt] : vertices) {
-        vrt.color = 'w';
-        vrt.d = INT_MAX;
-        vrt.pre = nullptr;
-    }
-    VertexInfo<K, D>& src = vertices[source];
-    src.color = 'g';
-    src.d = 0;
-    src.pre = nullptr;
-
-    queue<K> q;
-    q.push(source);
-    while(!q.empty()) {
-        K predecessor = q.front();
-        q.pop();
-
-        const auto& adj = vertices[predecessor].adj;
-
-        for (const tuple<K, int, string>& edge: adj) {
-            K v_key = get<0>(edge);
-            VertexInfo<K, D>& v = vertices[v_key];
-            if (v.color == 'w') {
-                v.color = 'g';
-                v.d = vertices[predecessor].d + 1;
-                v.pre = &vertices[predecessor].key;
-                q.push(v_key);
-            }
-        }
-        vertices[predecessor].color = 'b';
-    }
+    BFS(source, search);
+}
+
+//=================================================================
+// BFS
+// Performs Breadth-First Search without modifying the graph, so
+//   several searches can run on one graph at the same time as long
+//   as each has its own context
+// Parameters:  source - the starting vertex for BFS
+//              ctx - receives distances and predecessors
+// Returns:     none
+//=================================================================
+template <class K, class D>
+void Graph<K,D>::BFS ( K source, SearchContext& ctx ) const
+{
+    uint32_t s = index.find(source);
+    if (s == NO_VERTEX)
+        throw invalid_argument("Error in BFS: Source vertex not found.");
+    breadthFirstSearch(*this, s, ctx);
+}
+
+//=================================================================
+// BFS
+// Same as above, counting the work of the search in stats and
+//   adding it to StatsRegistry::global()
+// Parameters:  source - the starting vertex for BFS
+//              ctx - receives distances and predecessors
+//              stats - receives the counts and times of this search
+// Returns:     none
+// Throws:      invalid_argument if the source is not found
+//=================================================================
+template <class K, class D>
+void Graph<K,D>::BFS ( K source, SearchContext& ctx, QueryStats& stats ) const
+{
+    uint32_t s = index.find(source);
+    if (s == NO_VERTEX)
+        throw invalid_argument("Error in BFS: Source vertex not found.");
+    stats = QueryStats();
+    breadthFirstSearch(*this, s, ctx, stats);
+    StatsRegistry::global().record(stats);
 }
 
 //=================================================================
@@ -304,53 +851,410 @@ void Graph<K,D>::BFS ( K source )
 template <class K, class D>
 string Graph<K,D>::shortestPath ( K s, K d, bool weighted )
 {
-    if (!weighted) {
-        BFS(s);
-    } else {
-        dijkstra(s);
+    return shortestPath(s, d, weighted, search);
+}
+
+//=================================================================
+// shortestPath
+// Same as above, keeping the search state in the given context
+// Parameters:  s - source vertex key
+//              d - destination vertex key
+//              weighted - use dijkstra instead of BFS
+//              ctx - context for the search
+// Returns:     string representation of the shortest path
+//=================================================================
+template <class K, class D>
+string Graph<K,D>::shortestPath ( K s, K d, bool weighted, SearchContext& ctx ) const
+{
+    if (index.find(s) == NO_VERTEX || index.find(d) == NO_VERTEX) {
+        return "Either one or both of your input keys don't exist as a vertex.";
     }
 
-    if (vertices.find(s) == vertices.end() || vertices.find(d) == vertices.end()) {
+    return formatPathText(*this, findPath(s, d, weighted, ctx));
+}
+
+//=================================================================
+// shortestPath
+// Same as above, counting the work of the query in stats and adding
+//   it to StatsRegistry::global(). Formatting the path counts as
+//   part of the path phase.
+// Parameters:  s - source vertex key
+//              d - destination vertex key
+//              weighted - use dijkstra instead of BFS
+//              ctx - context for the search
+//              stats - receives the counts and times of this query
+// Returns:     string representation of the shortest path
+//=================================================================
+template <class K, class D>
+string Graph<K,D>::shortestPath ( K s, K d, bool weighted, SearchContext& ctx, QueryStats& stats ) const
+{
+    if (index.find(s) == NO_VERTEX || index.find(d) == NO_VERTEX) {
         return "Either one or both of your input keys don't exist as a vertex.";
+    }
+
+    stats = QueryStats();
+    Path path = searchPath(s, d, weighted, ctx, stats);
+    stats.phase(SearchPhase::Path);
+    string text = formatPathText(*this, path);
+    stats.finish();
+    StatsRegistry::global().record(stats);
+    return text;
+}
+
+//=================================================================
+// findPath
+// Finds the shortest path between two vertices using the calling
+//   thread's search context
+// Parameters:  s - source vertex key
+//              d - destination vertex key
+//              weighted - use dijkstra instead of BFS
+// Returns:     the path, empty if d cannot be reached
+// Throws:      invalid_argument if either vertex is not found
+//=================================================================
+template <class K, class D>
+Path Graph<K,D>::findPath ( K s, K d, bool weighted ) const
+{
+    return findPath(s, d, weighted, SearchContext::local());
+}
+
+//=================================================================
+// findPath
+// Same as above, keeping the search state in the given context
+// Parameters:  s - source vertex key
+//              d - destination vertex key
+//              weighted - use dijkstra instead of BFS
+//              ctx - context for the search
+// Returns:     the path, empty if d cannot be reached
+// Throws:      invalid_argument if either vertex is not found
+//=================================================================
+template <class K, class D>
+Path Graph<K,D>::findPath ( K s, K d, bool weighted, SearchContext& ctx ) const
+{
+    NoStats none;
+    return searchPath(s, d, weighted, ctx, none);
+}
+
+//=================================================================
+// findPath
+// Same as above, counting the work of the query in stats and adding
+//   it to StatsRegistry::global()
+// Parameters:  s - source vertex key
+//              d - destination vertex key
+//              weighted - use dijkstra instead of BFS
+//              ctx - context for the search
+//              stats - receives the counts and times of this query
+// Returns:     the path, empty if d cannot be reached
+// Throws:      invalid_argument if either vertex is not found
+//=================================================================
+template <class K, class D>
+Path Graph<K,D>::findPath ( K s, K d, bool weighted, SearchContext& ctx, QueryStats& stats ) const
+{
+    stats = QueryStats();
+    Path path = searchPath(s, d, weighted, ctx, stats);
+    StatsRegistry::global().record(stats);
+    return path;
+}
+
+//=================================================================
+// searchPath
+// findPath with a stats policy; NoStats compiles the counting away
+// Parameters:  s - source vertex key
+//              d - destination vertex key
+//              weighted - use dijkstra instead of BFS
+//              ctx - context for the search
+//              stats - stats policy, NoStats or QueryStats
+// Returns:     the path, empty if d cannot be reached
+// Throws:      invalid_argument if either vertex is not found
+//=================================================================
+template <class K, class D>
+template <class S>
+Path Graph<K,D>::searchPath ( K s, K d, bool weighted, SearchContext& ctx, S& stats ) const
+{
+    uint32_t src = index.find(s);
+    uint32_t dst = index.find(d);
+    if (src == NO_VERTEX || dst == NO_VERTEX)
+        throw invalid_argument("Error in findPath: One or both vertices not found.");
+
+    if (!weighted) {
+        breadthFirstSearch(*this, src, ctx, stats);
     } else {
-        return shortestPathRecursive(s, d, 0, weighted);
+        dijkstraSearch(*this, src, ctx, stats);
     }
+    stats.phase(SearchPhase::Path);
+    Path path = tracePath(*this, src, dst, weighted, ctx);
+    stats.finish();
+    return path;
+}
+
+//=================================================================
+// shortestPath
+// Finds the shortest path between the vertices nearest to two
+//   coordinates (see nearestVertex)
+// Parameters:  from - (longitude, latitude) of the start
+//              to - (longitude, latitude) of the destination
+//              weighted - use dijkstra instead of BFS
+// Returns:     string representation of the shortest path
+// Throws:      invalid_argument if the graph has no vertices
+//=================================================================
+template <class K, class D>
+string Graph<K,D>::shortestPath ( const tuple<double, double>& from, const tuple<double, double>& to, bool weighted )
+{
+    K s = nearestVertex(get<0>(from), get<1>(from));
+    K d = nearestVertex(get<0>(to), get<1>(to));
+    return shortestPath(s, d, weighted);
+}
+
+//=================================================================
+// findPath
+// Finds the shortest path between the vertices nearest to two
+//   coordinates (see nearestVertex)
+// Parameters:  from - (longitude, latitude) of the start
+//              to - (longitude, latitude) of the destination
+//              weighted - use dijkstra instead of BFS
+// Returns:     the path, empty if the destination cannot be reached
+// Throws:      invalid_argument if the graph has no vertices
+//=================================================================
+template <class K, class D>
+Path Graph<K,D>::findPath ( const tuple<double, double>& from, const tuple<double, double>& to, bool weighted ) const
+{
+    K s = nearestVertex(get<0>(from), get<1>(from));
+    K d = nearestVertex(get<0>(to), get<1>(to));
+    return findPath(s, d, weighted);
+}
+
+//=================================================================
+// spatialIndex
+// The k-d tree over vertex coordinates. It is built by the first
+//   query after the vertices change and shared by later ones; two
+//   threads racing to build it just build the same tree twice.
+// Parameters:  none
+// Returns:     the index
+//=================================================================
+template <class K, class D>
+shared_ptr<const KdTree> Graph<K,D>::spatialIndex ( ) const
+{
+    shared_ptr<const KdTree> tree = atomic_load(&spatial);
+    if (!tree) {
+        tree = make_shared<const KdTree>(*this);
+        atomic_store(&spatial, tree);
+    }
+    return tree;
+}
+
+//=================================================================
+// nearestVertex
+// Snaps a coordinate to the closest vertex by great-circle distance
+// Parameters:  lon, lat - coordinate in degrees
+// Returns:     key of the closest vertex
+// Throws:      invalid_argument if the graph has no vertices
+//=================================================================
+template <class K, class D>
+K Graph<K,D>::nearestVertex ( double lon, double lat ) const
+{
+    uint32_t u = spatialIndex()->nearest(lon, lat);
+    if (u == NO_VERTEX)
+        throw invalid_argument("Error in nearestVertex: Graph has no vertices.");
+    return vertices[u].key;
+}
+
+//=================================================================
+// nearestVertices
+// The k vertices closest to a coordinate by great-circle distance
+// Parameters:  lon, lat - coordinate in degrees
+//              k - number of vertices wanted
+// Returns:     keys of up to k vertices, closest first
+//=================================================================
+template <class K, class D>
+vector<K> Graph<K,D>::nearestVertices ( double lon, double lat, uint32_t k ) const
+{
+    vector<K> result;
+    for (uint32_t u : spatialIndex()->nearest(lon, lat, k))
+        result.push_back(vertices[u].key);
+    return result;
+}
+
+//=================================================================
+// verticesWithin
+// Every vertex within a great-circle distance of a coordinate
+// Parameters:  lon, lat - coordinate in degrees
+//              meters - the distance
+// Returns:     keys of the vertices, closest first
+//=================================================================
+template <class K, class D>
+vector<K> Graph<K,D>::verticesWithin ( double lon, double lat, double meters ) const
+{
+    vector<K> result;
+    for (uint32_t u : spatialIndex()->within(lon, lat, meters))
+        result.push_back(vertices[u].key);
+    return result;
+}
+
+//=================================================================
+// verticesInBox
+// Every vertex inside a longitude/latitude box. A box with minLon
+//   greater than maxLon wraps across the antimeridian.
+// Parameters:  minLon, minLat, maxLon, maxLat - the box in degrees
+// Returns:     keys of the vertices, in insertion order
+//=================================================================
+template <class K, class D>
+vector<K> Graph<K,D>::verticesInBox ( double minLon, double minLat, double maxLon, double maxLat ) const
+{
+    vector<K> result;
+    for (uint32_t u : spatialIndex()->inBox(minLon, minLat, maxLon, maxLat))
+        result.push_back(vertices[u].key);
+    return result;
 }
 
 //=================================================================
 // shortestPathRecursive
+// Formats the path to d found by the last search
 //=================================================================
 template <class K, class D>
 string Graph<K,D>::shortestPathRecursive ( K s, K d, double distance, bool weighted )
 {
-    if (s == d) {
-        VertexInfo<K, D>& s_string = vertices[s];
-        tuple<double, double> s_info = s_string.data;
-        return string("Total distance: ") + to_string(distance) + "\n(" + (to_string(get<0>(s_info))) + ", " + (to_string(get<1>(s_info))) + ")" + "\n";
-    } else if (vertices.at(d).pre == nullptr) {
-        return "";
-    } else {
+    return shortestPathRecursive(s, d, distance, weighted, search);
+}
 
-        VertexInfo<K, D>& d_string = vertices[d];
-        tuple<double, double> d_info = d_string.data;
-        string label;
-        double weight;
-        // assert(vertices.at(d).pre != nullptr);
-        for (auto& edge : vertices[*vertices.at(d).pre].adj) {
-            if (get<0>(edge) == d) {
-                label = get<2>(edge);
-                weight = get<1>(edge);
-            }
-        }
+//=================================================================
+// shortestPathRecursive
+// Formats the path to d found by a search into the given context.
+//   Despite the name the path is traced in one loop (see tracePath);
+//   the name is kept for existing callers.
+// Parameters:  s - source vertex key
+//              d - destination vertex key
+//              distance - added to every distance on the path
+//              weighted - sum edge weights instead of counting hops
+//              ctx - context holding the predecessors
+// Returns:     string representation of the path, "" if unreachable
+//=================================================================
+template <class K, class D>
+string Graph<K,D>::shortestPathRecursive ( K s, K d, double distance, bool weighted, const SearchContext& ctx ) const
+{
+    Path path = tracePath(*this, index.find(s), index.find(d), weighted, ctx);
+    for (double& x : path.distances)
+        x += distance;
+    return formatPathText(*this, path);
+}
 
-        if (weighted) {
-            distance += weight;
-        } else {
-            distance++;
-        }
-        string d_str = label + "(" + (to_string(get<0>(d_info))) + ", " + (to_string(get<1>(d_info))) + ")" + "\n";
-        return shortestPathRecursive(s, *vertices.at(d).pre, distance, weighted) + d_str;
+//=================================================================
+// distanceTable
+// Shortest weighted distances from each source to each target, on
+//   several threads. Each source runs one dijkstra that stops once
+//   every target is settled, instead of one full search per pair.
+// Parameters:  sources - source vertex keys, one row each
+//              targets - target vertex keys, one column each
+//              threads - number of threads, 0 for one per core
+// Returns:     sources.size() x targets.size() matrix of distances,
+//              SearchContext::INF where a target cannot be reached
+// Throws:      invalid_argument if a vertex is not found
+//=================================================================
+template <class K, class D>
+Matrix<double> Graph<K,D>::distanceTable ( const vector<K>& sources, const vector<K>& targets, unsigned threads ) const
+{
+    ThreadPool pool(threads > 0 ? threads : thread::hardware_concurrency());
+    return distanceTable(sources, targets, pool);
+}
+
+//=================================================================
+// distanceTable
+// Same as above on the threads of a pool
+// Parameters:  sources - source vertex keys, one row each
+//              targets - target vertex keys, one column each
+//              pool - threads to run on
+// Returns:     sources.size() x targets.size() matrix of distances
+// Throws:      invalid_argument if a vertex is not found
+//=================================================================
+template <class K, class D>
+Matrix<double> Graph<K,D>::distanceTable ( const vector<K>& sources, const vector<K>& targets, ThreadPool& pool ) const
+{
+    vector<uint32_t> from(sources.size());
+    vector<uint32_t> to(targets.size());
+    for (size_t i = 0; i < sources.size(); i++)
+        from[i] = index.find(sources[i]);
+    for (size_t j = 0; j < targets.size(); j++)
+        to[j] = index.find(targets[j]);
+    if (find(from.begin(), from.end(), NO_VERTEX) != from.end() || find(to.begin(), to.end(), NO_VERTEX) != to.end())
+        throw invalid_argument("Error in distanceTable: Vertex not found.");
+    return distanceTableSearch(*this, from, to, pool);
+}
+
+//=================================================================
+// astar
+// Finds the shortest weighted path between two vertices with A*,
+//   using the vertex coordinates to steer toward d. Returns the same
+//   string as shortestPath(s, d, true) but usually touches only a
+//   small part of the graph.
+// Parameters:  s - source vertex key
+//              d - destination vertex key
+// Returns:     string representation of the shortest path
+//=================================================================
+template <class K, class D>
+string Graph<K,D>::astar ( K s, K d )
+{
+    return astar(s, d, search);
+}
+
+//=================================================================
+// astar
+// Same as above, keeping the search state in the given context
+// Parameters:  s - source vertex key
+//              d - destination vertex key
+//              ctx - context for the search
+// Returns:     string representation of the shortest path
+//=================================================================
+template <class K, class D>
+string Graph<K,D>::astar ( K s, K d, SearchContext& ctx ) const
+{
+    uint32_t src = index.find(s);
+    uint32_t dst = index.find(d);
+    if (src == NO_VERTEX || dst == NO_VERTEX) {
+        return "Either one or both of your input keys don't exist as a vertex.";
+    }
+    astarSearch(*this, src, dst, ctx);
+    return formatPathText(*this, tracePath(*this, src, dst, true, ctx));
+}
+
+//=================================================================
+// shortestPathBidirectional
+// Finds the shortest path between two vertices by searching forward
+//   from s and backward from d until the searches meet, using the
+//   calling thread's search contexts. Returns a path of the same
+//   length and format as shortestPath.
+// Parameters:  s - source vertex key
+//              d - destination vertex key
+//              weighted - bidirectional dijkstra instead of BFS
+// Returns:     string representation of the shortest path
+//=================================================================
+template <class K, class D>
+string Graph<K,D>::shortestPathBidirectional ( K s, K d, bool weighted ) const
+{
+    return shortestPathBidirectional(s, d, weighted, SearchContext::local(0), SearchContext::local(1));
+}
+
+//=================================================================
+// shortestPathBidirectional
+// Same as above with explicit contexts for the two searches
+// Parameters:  s - source vertex key
+//              d - destination vertex key
+//              weighted - bidirectional dijkstra instead of BFS
+//              fwd - context for the forward search; receives the path
+//              bwd - context for the backward search
+// Returns:     string representation of the shortest path
+//=================================================================
+template <class K, class D>
+string Graph<K,D>::shortestPathBidirectional ( K s, K d, bool weighted, SearchContext& fwd, SearchContext& bwd ) const
+{
+    uint32_t src = index.find(s);
+    uint32_t dst = index.find(d);
+    if (src == NO_VERTEX || dst == NO_VERTEX) {
+        return "Either one or both of your input keys don't exist as a vertex.";
+    }
+    if (!weighted) {
+        bidirectionalBFS(*this, src, dst, fwd, bwd);
+    } else {
+        bidirectionalDijkstra(*this, src, dst, fwd, bwd);
     }
+    return formatPathText(*this, tracePath(*this, src, dst, weighted, fwd));
 }
 
 //=================================================================
@@ -358,86 +1262,291 @@ string Graph<K,D>::shortestPathRecursive ( K s, K d, double distance, bool weigh
 // Returns the adjacency matrix representation of the graph
 //   smallest key value corresponds to row/column 0, etc.
 //   use weight value for edges, INT_MAX for no edge
+//   Keys do not need to be 0..numV-1; each vertex index is mapped
+//   to its rank in key order. The caller must delete[] every row
+//   and then the array; adjacencyMatrix frees itself.
 // Parameters:  none
 // Returns:     2D array (matrix) of edge weights
 //=================================================================
 template <class K, class D>
 int** Graph<K,D>::asAdjMatrix ( ) const
 {
+    Matrix<int> dense = adjacencyMatrix();
     int** matrix = new int*[numV];
-
     for (int i = 0; i < numV; i++) {
         matrix[i] = new int[numV];
+        copy(dense.row(i), dense.row(i) + numV, matrix[i]);
     }
+    return matrix;
+}
 
-    for (int i = 0; i < numV; i++) {
-        for (int j = 0; j < numV; j++) {
-            matrix[i][j] = INT_MAX;
+//=================================================================
+// adjacencyMatrix
+// Same as asAdjMatrix, in one contiguous block. Weights are doubles
+//   and are truncated to int; a weight that is not finite (such as
+//   an edge cut with an infinite weight) or is at least INT_MAX
+//   becomes INT_MAX, the same as no edge, and a finite one at or
+//   below INT_MIN becomes INT_MIN.
+// Parameters:  none
+// Returns:     matrix of edge weights in key order, INT_MAX for no edge
+//=================================================================
+template <class K, class D>
+Matrix<int> Graph<K,D>::adjacencyMatrix ( ) const
+{
+    vector<uint32_t> rank = keyRanks();
+    Matrix<int> matrix(numV, numV, INT_MAX);
+    for (int k = 0; k < numV; k++) {
+        for (auto& edge : vertices[k].adj) {
+            // converting an out-of-range double to int is undefined
+            int weight = INT_MAX;
+            if (isfinite(edge.weight) && edge.weight < INT_MAX)
+                weight = edge.weight <= INT_MIN ? INT_MIN : int(edge.weight);
+            matrix(rank[k], rank[edge.target]) = weight;
         }
     }
+    return matrix;
+}
 
-    for (int k = 0; k < numV; k++) {
-        for (auto& edge : vertices.at(k).adj) {
-            K key = get<0>(edge);
-            int weight = get<1>(edge);
-            matrix[k][key] = weight;
+//=================================================================
+// matrixKeys
+// The key of each row and column of the matrix exports
+//   (adjacencyMatrix, adjacencyBits, sparseMatrix, ...)
+// Parameters:  none
+// Returns:     keys in increasing order; row i is matrixKeys()[i]
+//=================================================================
+template <class K, class D>
+vector<K> Graph<K,D>::matrixKeys ( ) const
+{
+    vector<K> keys;
+    keys.reserve(vertices.size());
+    for (uint32_t u : keyOrder())
+        keys.push_back(vertices[u].key);
+    return keys;
+}
+
+//=================================================================
+// adjacencyBits
+// The adjacency matrix with one bit per cell, set where there is an
+//   edge. A graph of 100k vertices takes 1.25 GB instead of 40 GB.
+// Parameters:  none
+// Returns:     bit matrix in key order (see matrixKeys)
+//=================================================================
+template <class K, class D>
+BitMatrix Graph<K,D>::adjacencyBits ( ) const
+{
+    vector<uint32_t> rank = keyRanks();
+    BitMatrix bits(numV, numV);
+    for (uint32_t u = 0; u < vertices.size(); u++) {
+        for (const auto& edge : vertices[u].adj)
+            bits.set(rank[u], rank[edge.target]);
+    }
+    return bits;
+}
+
+//=================================================================
+// reachabilityBits
+// Which vertices each vertex can reach, one BFS per vertex on
+//   several threads
+// Parameters:  threads - number of threads, 0 for one per core
+// Returns:     bit matrix in key order, cell (i, j) set if there is
+//              a path from i to j; every vertex reaches itself
+//=================================================================
+template <class K, class D>
+BitMatrix Graph<K,D>::reachabilityBits ( unsigned threads ) const
+{
+    ThreadPool pool(threads > 0 ? threads : thread::hardware_concurrency());
+    return reachabilityBits(pool);
+}
+
+//=================================================================
+// reachabilityBits
+// Same as above on the threads of a pool
+// Parameters:  pool - threads to run on
+// Returns:     bit matrix in key order
+//=================================================================
+template <class K, class D>
+BitMatrix Graph<K,D>::reachabilityBits ( ThreadPool& pool ) const
+{
+    vector<uint32_t> rank = keyRanks();
+    BitMatrix bits(numV, numV);
+    pool.parallelFor(vertices.size(), [&](size_t begin, size_t end, unsigned) {
+        SearchContext& ctx = SearchContext::local(0);
+        for (size_t u = begin; u < end; u++) {
+            breadthFirstSearch(*this, u, ctx);
+            for (uint32_t v = 0; v < vertices.size(); v++) {
+                if (ctx.reached(v))
+                    bits.set(rank[u], rank[v]);
+            }
         }
+    }, 16);
+    return bits;
+}
+
+//=================================================================
+// sparseMatrix
+// The weighted adjacency matrix in compressed sparse row form,
+//   which takes space proportional to the number of edges
+// Parameters:  none
+// Returns:     CSR matrix in key order (see matrixKeys), columns
+//              increasing within each row
+//=================================================================
+template <class K, class D>
+CsrMatrix Graph<K,D>::sparseMatrix ( ) const
+{
+    vector<uint32_t> rank = keyRanks();
+    CsrMatrix csr;
+    csr.numRows = numV;
+    csr.numCols = numV;
+    csr.offsets.reserve(numV + 1);
+    csr.columns.reserve(numE);
+    csr.values.reserve(numE);
+    csr.offsets.push_back(0);
+    vector<pair<uint32_t, double>> row;
+    for (uint32_t u : keyOrder()) {
+        row.clear();
+        for (const auto& edge : vertices[u].adj)
+            row.push_back(make_pair(rank[edge.target], edge.weight));
+        sort(row.begin(), row.end());
+        for (const auto& entry : row) {
+            csr.columns.push_back(entry.first);
+            csr.values.push_back(entry.second);
+        }
+        csr.offsets.push_back(csr.columns.size());
     }
+    return csr;
+}
 
-    return matrix;
+//=================================================================
+// coordinateMatrix
+// The weighted adjacency matrix as a list of (row, column, weight)
+// Parameters:  none
+// Returns:     COO matrix in key order, sorted by row then column
+//=================================================================
+template <class K, class D>
+CooMatrix Graph<K,D>::coordinateMatrix ( ) const
+{
+    return toCOO(sparseMatrix());
+}
+
+//=================================================================
+// allPairsShortestPaths
+// Shortest weighted distances between every pair of vertices with a
+//   blocked Floyd-Warshall (see floyd_warshall.h). Rows and columns
+//   are in key order, as in asAdjMatrix. For graphs of a few thousand
+//   vertices this is cheaper than many single-source searches.
+// Parameters:  threads - number of threads, 0 for one per core
+// Returns:     matrix of distances, SearchContext::INF for no path
+//=================================================================
+template <class K, class D>
+Matrix<double> Graph<K,D>::allPairsShortestPaths ( unsigned threads ) const
+{
+    ThreadPool pool(threads > 0 ? threads : thread::hardware_concurrency());
+    return allPairsShortestPaths(pool);
 }
 
+//=================================================================
+// allPairsShortestPaths
+// Same as above on the threads of a pool
+// Parameters:  pool - threads to run on
+// Returns:     matrix of distances, SearchContext::INF for no path
+//=================================================================
 template <class K, class D>
-struct VertexInfoLess {
-    bool operator()(VertexInfo<K, D> const& l,
-                    VertexInfo<K, D> const& r) const {
-        return l.d > r.d;
+Matrix<double> Graph<K,D>::allPairsShortestPaths ( ThreadPool& pool ) const
+{
+    vector<uint32_t> rank = keyRanks();
+    Matrix<double> dist(numV, numV, SearchContext::INF);
+    for (int k = 0; k < numV; k++) {
+        dist(rank[k], rank[k]) = 0;
+        for (auto& edge : vertices[k].adj) {
+            double& cell = dist(rank[k], rank[edge.target]);
+            cell = min(cell, edge.weight);
+        }
     }
-};
+    floydWarshall(dist, pool);
+    return dist;
+}
 
 //=================================================================
 // dijkstra
+// Computes shortest paths from s; the results are kept until the
+//   next search
 //=================================================================
 template <class K, class D> 
 void Graph<K,D>::dijkstra ( K s ) 
 {
-    // Initialize single source 
-    initializeSingleSource(s);
-    set<K> keys_processed; 
-
-    std::priority_queue<
-      VertexInfo<K, D>,
-      std::vector<VertexInfo<K, D>>,
-      VertexInfoLess<K, D>
-    > q;
- 
-    for (auto& [_, vrt] : vertices) {
-        q.push(vrt);
-    }
-
-    VertexInfo<K, D> u;
-    while (!q.empty()) { 
-        // these two lines act as EXTRACT-MIN 
-        u = q.top();
-        q.pop();
+    dijkstra(s, search);
+}
 
-        if (keys_processed.find(u.key) != keys_processed.end()) {
-            continue;
-        }
+//=================================================================
+// dijkstra
+// Computes shortest paths from s without modifying the graph
+// Parameters:  s - source vertex key
+//              ctx - receives distances and predecessors
+// Returns:     none
+//=================================================================
+template <class K, class D>
+void Graph<K,D>::dijkstra ( K s, SearchContext& ctx ) const
+{
+    uint32_t src = index.find(s);
+    if (src == NO_VERTEX)
+        throw invalid_argument("Error in dijkstra: Source vertex not found.");
+    dijkstraSearch(*this, src, ctx);
+}
 
-        // add u to the end of s
-        keys_processed.insert(u.key);
+//=================================================================
+// dijkstra
+// Same as above, counting the work of the search in stats and
+//   adding it to StatsRegistry::global()
+// Parameters:  s - source vertex key
+//              ctx - receives distances and predecessors
+//              stats - receives the counts and times of this search
+// Returns:     none
+// Throws:      invalid_argument if the source is not found
+//=================================================================
+template <class K, class D>
+void Graph<K,D>::dijkstra ( K s, SearchContext& ctx, QueryStats& stats ) const
+{
+    uint32_t src = index.find(s);
+    if (src == NO_VERTEX)
+        throw invalid_argument("Error in dijkstra: Source vertex not found.");
+    stats = QueryStats();
+    dijkstraSearch(*this, src, ctx, stats);
+    StatsRegistry::global().record(stats);
+}
 
-        for (auto& edge : u.adj) {
-            K v_key = get<0>(edge);
-            VertexInfo<K,D>& v = vertices.at(v_key);
+//=================================================================
+// deltaStepping
+// Computes shortest paths from s on several threads; the results
+//   are kept until the next search, exactly as dijkstra(s) leaves
+//   them
+// Parameters:  s - source vertex key
+//              delta - bucket width, <= 0 for the mean edge weight
+//              threads - number of threads, 0 for one per core
+// Returns:     none
+//=================================================================
+template <class K, class D>
+void Graph<K,D>::deltaStepping ( K s, double delta, unsigned threads )
+{
+    ThreadPool pool(threads > 0 ? threads : thread::hardware_concurrency());
+    deltaStepping(s, search, pool, delta);
+}
 
-            if (relax(u.key, v.key)) {
-                // decrease key
-                q.push(v);
-            }
-        }  
-    }
+//=================================================================
+// deltaStepping
+// Same as above on the threads of a pool, without modifying the graph
+// Parameters:  s - source vertex key
+//              ctx - receives distances and predecessors
+//              pool - threads to run on
+//              delta - bucket width, <= 0 for the mean edge weight
+// Returns:     none
+//=================================================================
+template <class K, class D>
+void Graph<K,D>::deltaStepping ( K s, SearchContext& ctx, ThreadPool& pool, double delta ) const
+{
+    uint32_t src = index.find(s);
+    if (src == NO_VERTEX)
+        throw invalid_argument("Error in deltaStepping: Source vertex not found.");
+    deltaSteppingSearch(*this, src, ctx, pool, delta);
 }
 
 //=================================================================
@@ -446,12 +1555,11 @@ void Graph<K,D>::dijkstra ( K s )
 template <class K, class D>
 void Graph<K,D>::initializeSingleSource ( K s )
 {
-    for (auto& [_, vrt] : vertices) {
-        vrt.d = INT_MAX;
-        vrt.pre = nullptr;
-    }
-
-    vertices.at(s).d = 0;
+    uint32_t src = index.find(s);
+    if (src == NO_VERTEX)
+        throw invalid_argument("Error in initializeSingleSource: Source vertex not found.");
+    search.reset(numV, src);
+    search.setDist(src, 0);
 }
 
 //=================================================================
@@ -460,18 +1568,40 @@ void Graph<K,D>::initializeSingleSource ( K s )
 template <class K, class D>
 bool Graph<K,D>::relax( K u, K v )
 {
-    int weight = 0;
-    for (auto& edge : vertices.at(u).adj) {
-        if (get<0>(edge) == v) {
-            weight = get<0>(edge);
+    uint32_t ui = index.find(u);
+    uint32_t vi = index.find(v);
+    // an unreached u has nothing to offer v
+    if (!search.reached(ui))
+        return false;
+
+    double weight = 0;
+    for (auto& edge : vertices[ui].adj) {
+        if (edge.target == vi) {
+            weight = edge.weight;
         }
     }
 
-    if (vertices.at(v).d > vertices.at(u).d + weight) {
-        vertices.at(v).d = vertices.at(u).d + weight;
-        vertices.at(v).pre = &vertices[u].key;
+    if (search.getDist(vi) > search.getDist(ui) + weight) {
+        search.setDist(vi, search.getDist(ui) + weight);
+        search.setPre(vi, ui);
         return true;
     } 
 
     return false;
 }
+
+//=================================================================
+// freeze
+// Builds an immutable CSR snapshot of the graph for read-only
+//   query workloads. Later changes to the graph are not reflected
+//   in the snapshot. Renumbering the vertices (see VertexOrder) keeps
+//   neighbors close in memory; keys are unchanged, so keyAt and
+//   indexOf map between the new numbering and the original keys.
+// Parameters:  order - vertex numbering, the graph's own by default
+// Returns:     the compact snapshot
+//=================================================================
+template <class K, class D>
+CompactGraph<K,D> Graph<K,D>::freeze ( VertexOrder order ) const
+{
+    return CompactGraph<K,D>(*this, order);
+}
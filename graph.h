@@ -14,54 +14,187 @@
 #include <map>
 #include <list>
 #include <tuple>
+#include <vector>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include "arena_list.h"
+#include "key_index.h"
+#include "label_pool.h"
+#include "kd_tree.h"
+#include "vertex_order.h"
+#include "search_context.h"
+#include "graph_search.h"
+#include "path.h"
+#include "floyd_warshall.h"
+#include "bit_matrix.h"
+#include "sparse_matrix.h"
 using namespace std;
 
+// An out-edge. The label text lives once in the graph's LabelPool.
+struct AdjEdge
+{
+    uint32_t   target;   // target vertex index
+    uint32_t   label;    // label id
+    double     weight;
+};
+
+// An in-edge, the reverse of an AdjEdge
+struct InEdge
+{
+    uint32_t   source;   // source vertex index
+    double     weight;
+};
+
+// The lists are allocated from the owning graph's storage
 template <class K, class D>
 struct VertexInfo
 {
     tuple<double, double>                     data;
-    int                                       key;
-    list<tuple<K, double, string>>    adj; // adjacency list
+    K                                         key;
+    ArenaList<AdjEdge>                        adj; // adjacency list
+    ArenaList<InEdge>                        radj; // reverse adjacency list
 
-    // attributes filled in during BFS/DFS
-    int                      d; // distance from source
-    K*                     pre; // predecessor in search
-    char                 color; // 'w', 'g', 'b'
-    
-    int                 d_time; // discovery time in DFS
-    int                 f_time; // finishing time in DFS
-    
+    // attributes filled in during BFS/DFS live in a SearchContext
 };
 
+// Where a graph allocates its adjacency lists. Both free everything
+// at once when the graph is destroyed.
+//   Pool  - reuses the memory of lists that grew, for graphs built
+//           one insertEdge at a time
+//   Arena - never reuses memory, for graphs built in one go by the
+//           bulk constructor, where every list is sized exactly
+enum class GraphStorage { Pool, Arena };
+
+template <class K, class D>
+class CompactGraph;
+
 template <class K, class D>
 class Graph
 {
+   friend class CompactGraph<K,D>;
 private:
+   // Adjacency lists come from here, so a graph of millions of small
+   // lists makes few calls to malloc and frees them all at once. It is
+   // declared first so it outlives the lists, and only one thread at a
+   // time allocates from it.
+   unique_ptr<pmr::memory_resource> storage;
+   GraphStorage            storageKind;
+   pmr::memory_resource*   upstream;     // where storage gets its memory
    int                         numV;    // number of vertices
    int                         numE;    // number of edges
-   map<K, VertexInfo<K,D>> vertices;    // mapping between vertex key and vertex info
-   void     DFSVisit    ( K u, int& time ); // helper for DFS
+   vector<VertexInfo<K,D>> vertices;    // vertex info, indexed by dense vertex index
+   KeyIndex<K>                index;    // mapping between vertex key and vertex index
+   LabelPool                 labels;    // edge label texts, by label id
+   SearchContext              search;    // results of the last BFS/DFS/dijkstra
+   double                 astarScale;    // min weight / straight-line length over all edges
+   mutable shared_ptr<const KdTree> spatial; // vertex coordinates, built on first use
+   shared_ptr<const KdTree> spatialIndex ( ) const;
+   void     noteEdgeForHeuristic ( uint32_t u, uint32_t v, double w );
+   double   heuristicLimit ( uint32_t u, uint32_t v, double w ) const;
+   void     buildEdges     ( const vector<tuple<K, K, double, string>>& edges, ThreadPool& pool );
+   void     buildEdges     ( const vector<tuple<K, K, double, uint32_t>>& edges, ThreadPool& pool );
+   template <class LK, class LD>
+   friend Graph<LK,LD> loadGraph ( const string& filename );   // interns labels and builds edges directly
+   vector<uint32_t> keyOrder ( ) const;             // indices sorted by key
+   vector<uint32_t> keyRanks ( ) const;             // index -> position in keyOrder
+   vector<vector<K>> wavefronts ( const vector<uint32_t>& order, const vector<uint32_t>& levels ) const;
+   template <class S>
+   Path     searchPath     ( K s, K d, bool weighted, SearchContext& ctx, S& stats ) const;
 public:
+   typedef const AdjEdge* EdgeIterator;
+   typedef const InEdge*  InEdgeIterator;
+
             Graph          ( );
-            Graph          ( vector<K> keys, vector<D> data, vector<tuple<K,K,int>> edges );
+   explicit Graph          ( GraphStorage kind, pmr::memory_resource* upstream = pmr::get_default_resource() );
+            Graph          ( const vector<K>& keys, const vector<tuple<double, double>>& data,
+                             const vector<tuple<K, K, double, string>>& edges, unsigned threads = 0,
+                             GraphStorage kind = GraphStorage::Pool );
+            Graph          ( const Graph& other );
+            Graph          ( Graph&& other );
+   Graph&   operator=      ( Graph other );
            ~Graph          ( );
+   void     swap           ( Graph& other );
 
    bool    isEdge          ( K v1, K v2 ) const;
-   int     getWeight       ( K v1, K v2 ) const;
-   void    insertEdge      ( K v1, K v2, int w, string label);
+   double  getWeight       ( K v1, K v2 ) const;
+   void    insertEdge      ( K v1, K v2, double w, const string& label );
+   void    insertEdges     ( const vector<tuple<K, K, double, string>>& edges );
+   void    insertEdges     ( const vector<tuple<K, K, double, string>>& edges, ThreadPool& pool );
+   void    reserve         ( uint32_t n );
    void    insertVertex    ( K key, tuple<double, double> data );
    int     size            ( ) {return numV;}
+   uint32_t indexOf        ( K key ) const;
+   const K& keyAt          ( uint32_t u ) const { return vertices[u].key; }
    string  toString        ( ) const;
    void    DFS             ( );
-   string  topologicalSort ( );
+   void    DFS             ( SearchContext& ctx ) const;
+   template <class V>
+   void    DFS             ( SearchContext& ctx, V& visitor ) const;
+   vector<K> topologicalOrder ( ) const;
+   string  topologicalSort ( ) const;
+   vector<vector<K>> topologicalLevels ( ) const;
+   vector<vector<K>> topologicalLevels ( ThreadPool& pool ) const;
    void    BFS             ( K source );
+   void    BFS             ( K source, SearchContext& ctx ) const;
+   void    BFS             ( K source, SearchContext& ctx, QueryStats& stats ) const;
    string  shortestPath    ( K s, K d, bool weighted = false );
+   string  shortestPath    ( K s, K d, bool weighted, SearchContext& ctx ) const;
+   string  shortestPath    ( K s, K d, bool weighted, SearchContext& ctx, QueryStats& stats ) const;
+   Path    findPath        ( K s, K d, bool weighted = false ) const;
+   Path    findPath        ( K s, K d, bool weighted, SearchContext& ctx ) const;
+   Path    findPath        ( K s, K d, bool weighted, SearchContext& ctx, QueryStats& stats ) const;
+   string  shortestPath    ( const tuple<double, double>& from, const tuple<double, double>& to, bool weighted = false );
+   Path    findPath        ( const tuple<double, double>& from, const tuple<double, double>& to, bool weighted = false ) const;
+   K       nearestVertex   ( double lon, double lat ) const;
+   vector<K> nearestVertices ( double lon, double lat, uint32_t k ) const;
+   vector<K> verticesWithin ( double lon, double lat, double meters ) const;
+   vector<K> verticesInBox ( double minLon, double minLat, double maxLon, double maxLat ) const;
    string  shortestPathRecursive    ( K s, K d, double distance, bool weighted );
+   string  shortestPathRecursive    ( K s, K d, double distance, bool weighted, const SearchContext& ctx ) const;
    void  dijkstra        ( K s );
+   void  dijkstra        ( K s, SearchContext& ctx ) const;
+   void  dijkstra        ( K s, SearchContext& ctx, QueryStats& stats ) const;
+   void  deltaStepping   ( K s, double delta = 0, unsigned threads = 0 );
+   void  deltaStepping   ( K s, SearchContext& ctx, ThreadPool& pool, double delta = 0 ) const;
+   Matrix<double> distanceTable ( const vector<K>& sources, const vector<K>& targets, unsigned threads = 0 ) const;
+   Matrix<double> distanceTable ( const vector<K>& sources, const vector<K>& targets, ThreadPool& pool ) const;
+   string  astar           ( K s, K d );
+   string  astar           ( K s, K d, SearchContext& ctx ) const;
+   string  shortestPathBidirectional ( K s, K d, bool weighted = false ) const;
+   string  shortestPathBidirectional ( K s, K d, bool weighted, SearchContext& fwd, SearchContext& bwd ) const;
    int**   asAdjMatrix     ( ) const;
+   Matrix<int> adjacencyMatrix ( ) const;
+   vector<K>   matrixKeys      ( ) const;
+   BitMatrix   adjacencyBits   ( ) const;
+   BitMatrix   reachabilityBits ( unsigned threads = 0 ) const;
+   BitMatrix   reachabilityBits ( ThreadPool& pool ) const;
+   CsrMatrix   sparseMatrix    ( ) const;
+   CooMatrix   coordinateMatrix ( ) const;
+   Matrix<double> allPairsShortestPaths ( unsigned threads = 0 ) const;
+   Matrix<double> allPairsShortestPaths ( ThreadPool& pool ) const;
    void    initializeSingleSource   ( K s );
    bool    relax           ( K u, K v );
+   CompactGraph<K,D> freeze ( VertexOrder order = VertexOrder::Insertion ) const;
+   const SearchContext& lastSearch ( ) const { return search; }
+
+   // adjacency access used by the algorithms in graph_search.h
+   uint32_t     numVertices ( ) const { return vertices.size(); }
+   EdgeIterator edgesBegin  ( uint32_t u ) const { return vertices[u].adj.begin(); }
+   EdgeIterator edgesEnd    ( uint32_t u ) const { return vertices[u].adj.end(); }
+   uint32_t     edgeTarget  ( EdgeIterator e ) const { return e->target; }
+   double       edgeWeight  ( EdgeIterator e ) const { return e->weight; }
+   const string& edgeLabel  ( EdgeIterator e ) const { return labels.text(e->label); }
+   InEdgeIterator inEdgesBegin ( uint32_t v ) const { return vertices[v].radj.begin(); }
+   InEdgeIterator inEdgesEnd   ( uint32_t v ) const { return vertices[v].radj.end(); }
+   uint32_t     inEdgeSource ( InEdgeIterator e ) const { return e->source; }
+   double       inEdgeWeight ( InEdgeIterator e ) const { return e->weight; }
+   const tuple<double, double>& vertexData ( uint32_t u ) const { return vertices[u].data; }
+   double       heuristicScale ( ) const;
 };
 #include "graph.cpp"
+#include "compact_graph.h"
+#include "contraction_hierarchy.h"
+#include "shortest_path_tree.h"
 #endif
 //tuple<tuple<string>, int>
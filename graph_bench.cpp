@@ -0,0 +1,174 @@
+// *******************************************
+//  graph_bench.cpp
+//  CS 271 Graph Project
+//  Benchmarks of the graph algorithms on generated road networks
+// *******************************************
+//
+//  Usage: graph_bench [--max V] [--repeat R] [--kind grid|geometric|all]
+//
+//  Runs each algorithm once to warm up, then R timed times, on graphs
+//  of 1k, 10k, ... up to V vertices (default 1M, at most 10M). Prints
+//  one JSON object per graph and algorithm, for example
+//    {"graph":"grid","vertices":10000,"edges":37000,"algorithm":"BFS",
+//     "runs":5,"min_s":...,"p50_s":...,"p90_s":...,"p99_s":...,
+//     "max_s":...,"edges_per_sec":...,"peak_rss_kb":...}
+//  where edges_per_sec is edges divided by the median time and
+//  peak_rss_kb is the peak memory of the process so far.
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <cstdio>
+#include <sys/resource.h>
+#include "graph.h"
+#include "graph_io.h"
+#include "graph_generator.h"
+using namespace std;
+
+// asAdjMatrix needs V * V ints, so it only runs on graphs this small;
+// larger ones would also set the peak memory of every later result
+const uint32_t MATRIX_LIMIT = 2000;
+
+// measure: runs f once to warm up, then repeats times, and returns the
+// time of each timed run in seconds
+vector<double> measure(int repeats, const function<void(int)>& f)
+{
+    f(0);
+    vector<double> seconds;
+    for (int r = 0; r < repeats; r++) {
+        auto start = chrono::steady_clock::now();
+        f(r);
+        auto end = chrono::steady_clock::now();
+        seconds.push_back(chrono::duration<double>(end - start).count());
+    }
+    return seconds;
+}
+
+// percentile: nearest-rank percentile of sorted times
+double percentile(const vector<double>& sorted, double p)
+{
+    size_t rank = size_t(ceil(p / 100 * sorted.size()));
+    return sorted[rank == 0 ? 0 : rank - 1];
+}
+
+// report: prints one result line
+void report(const string& graph, size_t vertices, size_t edges, const string& algorithm, vector<double> seconds)
+{
+    sort(seconds.begin(), seconds.end());
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    double median = percentile(seconds, 50);
+
+    cout << "{\"graph\":";
+    jsonString(cout, graph);
+    cout << ",\"vertices\":" << vertices << ",\"edges\":" << edges << ",\"algorithm\":";
+    jsonString(cout, algorithm);
+    cout << ",\"runs\":" << seconds.size() << ",\"min_s\":";
+    jsonNumber(cout, seconds.front());
+    cout << ",\"p50_s\":";
+    jsonNumber(cout, median);
+    cout << ",\"p90_s\":";
+    jsonNumber(cout, percentile(seconds, 90));
+    cout << ",\"p99_s\":";
+    jsonNumber(cout, percentile(seconds, 99));
+    cout << ",\"max_s\":";
+    jsonNumber(cout, seconds.back());
+    cout << ",\"edges_per_sec\":";
+    jsonNumber(cout, median > 0 ? edges / median : 0);
+    cout << ",\"peak_rss_kb\":" << usage.ru_maxrss << "}" << endl;
+}
+
+// benchmark: times every algorithm on one generated graph
+void benchmark(const string& name, const GeneratedGraph& generated, int repeats)
+{
+    size_t n = generated.keys.size();
+    size_t m = generated.edges.size();
+    string filename = "graph_bench_" + name + ".txt";
+    writeGraphText(generated, filename);
+    report(name, n, m, "load", measure(repeats, [&](int) {
+        loadGraph<int, string>(filename);
+    }));
+    remove(filename.c_str());
+
+    Graph<int, string> g(generated.keys, generated.coords, generated.edges);
+    // the same random sources and destinations for every algorithm
+    mt19937 rng(1);
+    vector<int> sources, targets;
+    for (int r = 0; r < repeats; r++) {
+        sources.push_back(generated.keys[rng() % n]);
+        targets.push_back(generated.keys[rng() % n]);
+    }
+
+    report(name, n, m, "BFS", measure(repeats, [&](int r) {
+        g.BFS(sources[r]);
+    }));
+    report(name, n, m, "DFS", measure(repeats, [&](int) {
+        g.DFS();
+    }));
+    report(name, n, m, "dijkstra", measure(repeats, [&](int r) {
+        g.dijkstra(sources[r]);
+    }));
+    report(name, n, m, "shortestPath", measure(repeats, [&](int r) {
+        g.shortestPath(sources[r], targets[r], true);
+    }));
+    if (n <= MATRIX_LIMIT) {
+        report(name, n, m, "asAdjMatrix", measure(repeats, [&](int) {
+            int** matrix = g.asAdjMatrix();
+            for (size_t i = 0; i < n; i++)
+                delete[] matrix[i];
+            delete[] matrix;
+        }));
+    }
+
+    // road networks have cycles, so sort the forward edges only
+    GeneratedGraph forward = acyclicSubgraph(generated);
+    Graph<int, string> dag(forward.keys, forward.coords, forward.edges);
+    report(name, n, forward.edges.size(), "topologicalSort", measure(repeats, [&](int) {
+        dag.topologicalSort();
+    }));
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t maxVertices = 1000000;
+    int repeats = 5;
+    string kind = "all";
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string option = argv[i];
+        if (option == "--max") {
+            maxVertices = min(stoul(argv[i + 1]), 10000000ul);
+        } else if (option == "--repeat") {
+            repeats = max(stoi(argv[i + 1]), 1);
+        } else if (option == "--kind") {
+            kind = argv[i + 1];
+        } else {
+            cerr << "Unknown option " << option << endl;
+            return 1;
+        }
+    }
+    if (argc % 2 == 0 || (kind != "all" && kind != "grid" && kind != "geometric")) {
+        cerr << "Usage: graph_bench [--max V] [--repeat R] [--kind grid|geometric|all]" << endl;
+        return 1;
+    }
+
+    try {
+        for (uint32_t n = 1000; n <= maxVertices; n *= 10) {
+            if (kind != "geometric") {
+                uint32_t side = uint32_t(round(sqrt(double(n))));
+                benchmark("grid", gridRoadGraph(side, side, n), repeats);
+            }
+            if (kind != "grid") {
+                benchmark("geometric", geometricRoadGraph(n, 3, n), repeats);
+            }
+        }
+    }
+    catch (std::exception& e) {
+        cerr << "Error in benchmark: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
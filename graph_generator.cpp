@@ -0,0 +1,208 @@
+//=================================================================
+// CS 271 - Project 6
+// graph_generator.cpp
+// Fall 2025
+// This is the implementation file for the synthetic road network
+// generators
+//=================================================================
+
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <fstream>
+#include <cstdio>
+#include <stdexcept>
+#include "graph_search.h"
+#include "kd_tree.h"
+
+
+//=================================================================
+// scrambledKeys
+// Distinct keys in random order, the way map data numbers its nodes
+// Parameters:  n - number of keys
+//              rng - random source
+// Returns:     the keys
+//=================================================================
+inline vector<int> scrambledKeys ( uint32_t n, mt19937_64& rng )
+{
+    vector<int> keys(n);
+    iota(keys.begin(), keys.end(), 0);
+    shuffle(keys.begin(), keys.end(), rng);
+    // spread the keys out so they are not a dense range either
+    for (int& key : keys)
+        key = key * 97 + 1000;
+    return keys;
+}
+
+//=================================================================
+// ordinal
+// Writes a number as an English ordinal, as in street names
+// Parameters:  n - the number
+// Returns:     "1st", "2nd", "3rd", "4th", ..., "11th", ..., "21st", ...
+//=================================================================
+inline string ordinal ( uint32_t n )
+{
+    const char* suffix = "th";
+    if (n % 100 < 11 || n % 100 > 13) {
+        if (n % 10 == 1)
+            suffix = "st";
+        else if (n % 10 == 2)
+            suffix = "nd";
+        else if (n % 10 == 3)
+            suffix = "rd";
+    }
+    return to_string(n) + suffix;
+}
+
+//=================================================================
+// addStreet
+// Adds a two-way (or sometimes one-way) street between two vertices
+// Parameters:  graph - the graph being built
+//              u, v - vertex positions in graph.keys
+//              name - street name, "" for none
+//              rng - random source
+// Returns:     none
+//=================================================================
+inline void addStreet ( GeneratedGraph& graph, uint32_t u, uint32_t v, const string& name, mt19937_64& rng )
+{
+    // real road lengths run a bit over the straight line
+    uniform_real_distribution<double> detour(1.0, 1.3);
+    double length = haversineDistance(graph.coords[u], graph.coords[v]) * detour(rng);
+    graph.edges.emplace_back(graph.keys[u], graph.keys[v], length, name);
+    if (rng() % 10 != 0)
+        graph.edges.emplace_back(graph.keys[v], graph.keys[u], length, name);
+}
+
+//=================================================================
+// gridRoadGraph
+// A city grid: blocks of about 100 m with jittered intersections,
+//   a few missing blocks, named avenues and mostly unnamed streets
+// Parameters:  width, height - intersections in each direction
+//              seed - random seed, the same seed gives the same graph
+// Returns:     the graph
+// Throws:      invalid_argument if width * height overflows an int key
+//=================================================================
+inline GeneratedGraph gridRoadGraph ( uint32_t width, uint32_t height, uint64_t seed )
+{
+    uint64_t n = uint64_t(width) * height;
+    if (n > 20000000)
+        throw invalid_argument("Error in gridRoadGraph: Grid is too large.");
+    mt19937_64 rng(seed);
+    GeneratedGraph graph;
+    graph.keys = scrambledKeys(n, rng);
+
+    // about 100 m between intersections near latitude 40
+    const double STEP_LAT = 0.0009;
+    const double STEP_LON = 0.0012;
+    uniform_real_distribution<double> jitter(-0.2, 0.2);
+    graph.coords.resize(n);
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            graph.coords[uint64_t(y) * width + x] = make_tuple(-82.5 + (x + jitter(rng)) * STEP_LON, 40.0 + (y + jitter(rng)) * STEP_LAT);
+        }
+    }
+
+    graph.edges.reserve(4 * n);
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            uint32_t u = y * width + x;
+            // every tenth row and column is a named avenue that is never cut
+            if (x + 1 < width && (y % 10 == 0 || rng() % 20 != 0))
+                addStreet(graph, u, u + 1, y % 10 == 0 ? ordinal(y / 10 + 1) + " Avenue" : "", rng);
+            if (y + 1 < height && (x % 10 == 0 || rng() % 20 != 0))
+                addStreet(graph, u, u + width, x % 10 == 0 ? ordinal(x / 10 + 1) + " Street" : "", rng);
+        }
+    }
+    return graph;
+}
+
+//=================================================================
+// geometricRoadGraph
+// A random geometric graph: points scattered over a square region
+//   (about one per hectare), each joined to its nearest neighbors
+// Parameters:  n - number of vertices
+//              neighbors - nearest neighbors each vertex joins
+//              seed - random seed, the same seed gives the same graph
+// Returns:     the graph
+// Throws:      invalid_argument if n is too large for int keys
+//=================================================================
+inline GeneratedGraph geometricRoadGraph ( uint32_t n, uint32_t neighbors, uint64_t seed )
+{
+    if (n > 20000000)
+        throw invalid_argument("Error in geometricRoadGraph: Too many vertices.");
+    mt19937_64 rng(seed);
+    GeneratedGraph graph;
+    graph.keys = scrambledKeys(n, rng);
+
+    double side = sqrt(double(n)) * 0.0012;
+    uniform_real_distribution<double> lon(-82.5, -82.5 + side);
+    uniform_real_distribution<double> lat(40.0, 40.0 + side * 0.75);
+    graph.coords.resize(n);
+    for (auto& p : graph.coords)
+        p = make_tuple(lon(rng), lat(rng));
+
+    // the nearest point to each vertex is itself, so ask for one more
+    KdTree tree(graph.coords);
+    vector<vector<uint32_t>> near(n);
+    for (uint32_t u = 0; u < n; u++)
+        near[u] = tree.nearest(get<0>(graph.coords[u]), get<1>(graph.coords[u]), neighbors + 1);
+
+    graph.edges.reserve(2 * uint64_t(n) * neighbors);
+    for (uint32_t u = 0; u < n; u++) {
+        for (uint32_t v : near[u]) {
+            // each pair once: from the lower position, unless only the
+            // higher one has the other among its neighbors
+            if (v == u || (v < u && find(near[v].begin(), near[v].end(), u) != near[v].end()))
+                continue;
+            addStreet(graph, u, v, rng() % 4 == 0 ? "Road " + to_string(u % 1000) : "", rng);
+        }
+    }
+    return graph;
+}
+
+//=================================================================
+// acyclicSubgraph
+// The edges of a graph that go from an earlier vertex to a later
+//   one, which leaves a DAG for topological sorting
+// Parameters:  graph - the graph
+// Returns:     the same vertices with the forward edges
+//=================================================================
+inline GeneratedGraph acyclicSubgraph ( const GeneratedGraph& graph )
+{
+    // keys are distinct, so comparing them orders the vertices
+    GeneratedGraph dag;
+    dag.keys = graph.keys;
+    dag.coords = graph.coords;
+    for (const auto& edge : graph.edges) {
+        if (get<0>(edge) < get<1>(edge))
+            dag.edges.push_back(edge);
+    }
+    return dag;
+}
+
+//=================================================================
+// writeGraphText
+// Writes a graph in the text format loadGraph reads
+// Parameters:  graph - the graph
+//              filename - file to write
+// Returns:     none
+// Throws:      runtime_error if the file cannot be written
+//=================================================================
+inline void writeGraphText ( const GeneratedGraph& graph, const string& filename )
+{
+    ofstream out(filename);
+    if (!out)
+        throw runtime_error("Error in writeGraphText: cannot write " + filename);
+    char buffer[64];
+    out << graph.keys.size() << ' ' << graph.edges.size() << '\n';
+    for (size_t i = 0; i < graph.keys.size(); i++) {
+        snprintf(buffer, sizeof(buffer), " %.7f %.7f\n", get<0>(graph.coords[i]), get<1>(graph.coords[i]));
+        out << graph.keys[i] << buffer;
+    }
+    for (const auto& edge : graph.edges) {
+        snprintf(buffer, sizeof(buffer), " %.17g ", get<2>(edge));
+        out << get<0>(edge) << ' ' << get<1>(edge) << buffer << get<3>(edge) << '\n';
+    }
+    if (!out)
+        throw runtime_error("Error in writeGraphText: cannot write " + filename);
+}
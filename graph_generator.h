@@ -0,0 +1,35 @@
+//=================================================================
+// CS 271 - Project 6
+// graph_generator.h
+// Fall 2025
+// This is the declaration file for the synthetic road network
+// generators used by the benchmarks
+//=================================================================
+
+#ifndef GRAPH_GENERATOR_H
+#define GRAPH_GENERATOR_H
+
+#include <string>
+#include <vector>
+#include <tuple>
+#include <cstdint>
+using namespace std;
+
+// A graph in the form the Graph constructor takes. Like denison.txt,
+// keys are large ids in no particular order, coordinates are
+// (longitude, latitude) in degrees, weights are lengths in meters and
+// most edges are two-way streets, some of them named.
+struct GeneratedGraph
+{
+    vector<int>                              keys;
+    vector<tuple<double, double>>            coords;
+    vector<tuple<int, int, double, string>>  edges;
+};
+
+GeneratedGraph gridRoadGraph       ( uint32_t width, uint32_t height, uint64_t seed );
+GeneratedGraph geometricRoadGraph  ( uint32_t n, uint32_t neighbors, uint64_t seed );
+GeneratedGraph acyclicSubgraph     ( const GeneratedGraph& graph );
+void           writeGraphText      ( const GeneratedGraph& graph, const string& filename );
+
+#include "graph_generator.cpp"
+#endif
@@ -0,0 +1,169 @@
+//=================================================================
+// CS 271 - Project 6
+// graph_io.cpp
+// Fall 2025
+// This is the implementation file for reading graphs from files
+//=================================================================
+
+#include <charconv>
+#include <stdexcept>
+#include <type_traits>
+
+
+//=================================================================
+// TextScanner constructor
+// Parameters:  begin, end - the text to scan
+// Returns:     none
+//=================================================================
+inline TextScanner::TextScanner ( const char* begin, const char* end ) : pos(begin), end(end), line(1)
+{
+}
+
+//=================================================================
+// skipBlanks
+// Moves past spaces, tabs and line breaks
+// Parameters:  none
+// Returns:     none
+//=================================================================
+inline void TextScanner::skipBlanks ( )
+{
+    while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\r' || *pos == '\n')) {
+        line += *pos == '\n';
+        pos++;
+    }
+}
+
+//=================================================================
+// endToken
+// Checks that the token just parsed ends where it should
+// Parameters:  what - what was expected, for the error message
+// Returns:     none
+// Throws:      invalid_argument if the token runs on into other text
+//=================================================================
+inline void TextScanner::endToken ( const char* what ) const
+{
+    if (pos < end && *pos != ' ' && *pos != '\t' && *pos != '\r' && *pos != '\n')
+        fail(what);
+}
+
+//=================================================================
+// fail
+// Throws a parse error naming the current line
+// Parameters:  what - what was expected
+// Returns:     none
+//=================================================================
+inline void TextScanner::fail ( const char* what ) const
+{
+    throw invalid_argument("Error in loadGraph: expected " + string(what) + " on line " + to_string(line));
+}
+
+//=================================================================
+// readInteger
+// Parses the next integer token
+// Parameters:  none
+// Returns:     the value
+// Throws:      invalid_argument if there is no integer, or it is
+//              followed by something other than a blank
+//=================================================================
+template <class T>
+T TextScanner::readInteger ( )
+{
+    skipBlanks();
+    T value;
+    auto result = from_chars(pos, end, value);
+    if (result.ec != errc())
+        fail("an integer");
+    pos = result.ptr;
+    endToken("an integer");
+    return value;
+}
+
+//=================================================================
+// readDouble
+// Parses the next floating point token
+// Parameters:  none
+// Returns:     the value
+// Throws:      invalid_argument if there is no number, or it is
+//              followed by something other than a blank
+//=================================================================
+inline double TextScanner::readDouble ( )
+{
+    skipBlanks();
+    double value;
+    auto result = from_chars(pos, end, value);
+    if (result.ec != errc())
+        fail("a number");
+    pos = result.ptr;
+    endToken("a number");
+    return value;
+}
+
+//=================================================================
+// readRestOfLine
+// Returns the rest of the current line without surrounding blanks
+//   and moves to the start of the next line
+// Parameters:  none
+// Returns:     the trimmed text, "" if the line has nothing left;
+//              a view into the scanned buffer
+//=================================================================
+inline string_view TextScanner::readRestOfLine ( )
+{
+    const char* first = pos;
+    while (pos < end && *pos != '\n')
+        pos++;
+    const char* last = pos;
+    if (pos < end) {
+        pos++;
+        line++;
+    }
+    while (first < last && (*first == ' ' || *first == '\t'))
+        first++;
+    while (last > first && (last[-1] == ' ' || last[-1] == '\t' || last[-1] == '\r'))
+        last--;
+    return string_view(first, last - first);
+}
+
+//=================================================================
+// loadGraph
+// Reads a graph in the denison.txt text format. The file is mapped
+//   rather than streamed, numbers are parsed with from_chars, the
+//   vertex storage is sized from the header, and all edges go in
+//   through one parallel buildEdges call. Each label is interned
+//   straight from the mapping as it is read, so no per-edge string
+//   is ever made. Weights keep full double precision.
+// Parameters:  filename - path of the file
+// Returns:     the graph
+// Throws:      runtime_error if the file cannot be read,
+//              invalid_argument if it is malformed
+//=================================================================
+template <class K, class D>
+Graph<K,D> loadGraph ( const string& filename )
+{
+    static_assert(is_integral<K>::value, "loadGraph reads integer keys");
+    MappedFile file(filename);
+    TextScanner in(file.data(), file.data() + file.size());
+
+    uint32_t numVertices = in.readInteger<uint32_t>();
+    uint32_t numEdges = in.readInteger<uint32_t>();
+
+    Graph<K,D> g;
+    g.reserve(numVertices);
+    for (uint32_t i = 0; i < numVertices; i++) {
+        K key = in.readInteger<K>();
+        double x = in.readDouble();
+        double y = in.readDouble();
+        g.insertVertex(key, make_tuple(x, y));
+    }
+
+    vector<tuple<K, K, double, uint32_t>> edges;
+    edges.reserve(numEdges);
+    for (uint32_t i = 0; i < numEdges; i++) {
+        K from = in.readInteger<K>();
+        K to = in.readInteger<K>();
+        double weight = in.readDouble();
+        edges.emplace_back(from, to, weight, g.labels.intern(in.readRestOfLine()));
+    }
+    ThreadPool pool;
+    g.buildEdges(edges, pool);
+    return g;
+}
@@ -0,0 +1,49 @@
+//=================================================================
+// CS 271 - Project 6
+// graph_io.h
+// Fall 2025
+// This is the declaration file for reading graphs from files
+//=================================================================
+
+#ifndef GRAPH_IO_H
+#define GRAPH_IO_H
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include "graph.h"
+#include "mapped_file.h"
+using namespace std;
+
+// Reads the text format of denison.txt straight from a mapped buffer:
+//   V E
+//   key longitude latitude            (V lines)
+//   from to weight [label ...]        (E lines)
+// Tokens are separated by spaces or tabs, lines may end in \r\n, and
+// the label is the rest of the line with surrounding blanks removed.
+// A number must be followed by a blank or the end of its line, so
+// "12.5abc" is an error rather than 12.5 with label "abc".
+class TextScanner
+{
+private:
+   const char*  pos;
+   const char*  end;
+   size_t       line;     // 1-based line of pos, for error messages
+
+   void         skipBlanks  ( );
+   void         endToken    ( const char* what ) const;
+   void         fail        ( const char* what ) const;
+public:
+                TextScanner ( const char* begin, const char* end );
+
+   template <class T>
+   T            readInteger ( );
+   double       readDouble  ( );
+   string_view  readRestOfLine ( );
+};
+
+template <class K, class D>
+Graph<K,D>   loadGraph      ( const string& filename );
+
+#include "graph_io.cpp"
+#endif
@@ -0,0 +1,1165 @@
+//=================================================================
+// CS 271 - Project 6
+// graph_search.cpp
+// Fall 2025
+// This is the implementation file for the shared search algorithms
+//=================================================================
+
+#include <cmath>
+#include <atomic>
+#include <algorithm>
+#include <map>
+#include <queue>
+#include <sstream>
+#include <string>
+#include <stdexcept>
+
+
+
+//=================================================================
+// breadthFirstSearch
+// Performs Breadth-First Search starting from the given source vertex
+// Parameters:  g - graph to search
+//              s - index of the source vertex
+//              ctx - receives distances (in edges) and predecessors
+// Returns:     none
+//=================================================================
+template <class G>
+void breadthFirstSearch ( const G& g, uint32_t s, SearchContext& ctx )
+{
+    NoStats none;
+    breadthFirstSearch(g, s, ctx, none);
+}
+
+//=================================================================
+// breadthFirstSearch
+// Same as above, counting the work in stats (see search_stats.h)
+// Parameters:  g - graph to search
+//              s - index of the source vertex
+//              ctx - receives distances (in edges) and predecessors
+//              stats - stats policy, NoStats or QueryStats
+// Returns:     none
+//=================================================================
+template <class G, class S>
+void breadthFirstSearch ( const G& g, uint32_t s, SearchContext& ctx, S& stats )
+{
+    stats.phase(SearchPhase::Initialize);
+    ctx.reset(g.numVertices(), s);
+    ctx.setColor(s, 'g');
+    ctx.setDist(s, 0);
+
+    // the queue is a flat FIFO of indices, every vertex enters it once
+    vector<uint32_t>& q = ctx.scratch();
+    q.clear();
+    q.push_back(s);
+    stats.pushed();
+    stats.phase(SearchPhase::Search);
+    for (size_t head = 0; head < q.size(); head++) {
+        uint32_t u = q[head];
+        stats.popped();
+        stats.settled();
+        double du = ctx.getDist(u);
+        for (auto e = g.edgesBegin(u); e != g.edgesEnd(u); ++e) {
+            uint32_t v = g.edgeTarget(e);
+            stats.scanned();
+            if (ctx.getColor(v) == 'w') {
+                ctx.setColor(v, 'g');
+                ctx.setDist(v, du + 1);
+                ctx.setPre(v, u);
+                q.push_back(v);
+                stats.relaxed();
+                stats.pushed();
+            }
+        }
+        ctx.setColor(u, 'b');
+    }
+    stats.finish();
+}
+
+//=================================================================
+// parallelBreadthFirstSearch
+// Level-synchronous BFS that expands each frontier on all threads
+//   of the pool, with the same distances and predecessors as
+//   breadthFirstSearch. Each level either pushes from the frontier
+//   (top-down, an atomic min per target) or, once the frontier's
+//   edges outnumber a fraction of the unexplored ones, lets every
+//   unreached vertex scan its in-edges for a frontier parent
+//   (bottom-up). Either way a vertex keeps the parent edge the
+//   sequential queue would reach first: lowest frontier position,
+//   then lowest edge id. The next frontier is ordered by that edge,
+//   which is exactly the sequential queue order.
+// Parameters:  g - graph to search
+//              s - index of the source vertex
+//              ctx - receives distances (in edges) and predecessors
+//              pool - threads to run on
+// Returns:     none
+//=================================================================
+template <class G>
+void parallelBreadthFirstSearch ( const G& g, uint32_t s, SearchContext& ctx, ThreadPool& pool )
+{
+    const uint64_t NONE = UINT64_MAX;
+    const uint32_t UNSEEN = UINT32_MAX;
+    const uint64_t ALPHA = 14;   // go bottom-up when frontier edges * ALPHA > unexplored edges
+    const uint64_t BETA = 24;    // go back top-down when frontier * BETA < vertices
+    uint32_t n = g.numVertices();
+
+    // parent[v] is (frontier position << 32 | edge id) of the best edge into v this level
+    vector<atomic<uint64_t>> parent(n);
+    vector<uint32_t> depth(n, UNSEEN);
+    vector<uint32_t> position(n);   // position in the frontier of its level
+    vector<uint32_t> pre(n, NO_VERTEX);
+    pool.parallelFor(n, [&](size_t lo, size_t hi, unsigned) {
+        for (size_t v = lo; v < hi; v++)
+            parent[v].store(NONE, memory_order_relaxed);
+    });
+
+    vector<uint32_t> frontier(1, s);
+    vector<uint32_t> next;
+    vector<uint32_t> start;
+    vector<vector<uint32_t>> found(pool.size());
+    vector<uint64_t> degrees(pool.size());
+    depth[s] = 0;
+    position[s] = 0;
+    uint64_t frontierEdges = g.outDegree(s);
+    uint64_t unexploredEdges = g.numEdges() - frontierEdges;
+    bool bottomUp = false;
+
+    for (uint32_t level = 0; !frontier.empty(); level++) {
+        if (!bottomUp && frontierEdges * ALPHA > unexploredEdges)
+            bottomUp = true;
+        else if (bottomUp && frontier.size() * BETA < n)
+            bottomUp = false;
+
+        for (auto& list : found)
+            list.clear();
+        if (!bottomUp) {
+            pool.parallelFor(frontier.size(), [&](size_t lo, size_t hi, unsigned worker) {
+                for (size_t i = lo; i < hi; i++) {
+                    for (auto e = g.edgesBegin(frontier[i]); e != g.edgesEnd(frontier[i]); ++e) {
+                        uint32_t v = g.edgeTarget(e);
+                        if (depth[v] != UNSEEN)
+                            continue;
+                        uint64_t key = uint64_t(i) << 32 | g.edgeId(e);
+                        uint64_t old = parent[v].load(memory_order_relaxed);
+                        while (key < old && !parent[v].compare_exchange_weak(old, key, memory_order_relaxed)) { }
+                        if (old == NONE)
+                            found[worker].push_back(v);
+                    }
+                }
+            });
+        } else {
+            pool.parallelFor(n, [&](size_t lo, size_t hi, unsigned worker) {
+                for (size_t v = lo; v < hi; v++) {
+                    if (depth[v] != UNSEEN)
+                        continue;
+                    // no early exit: the parent must be the lowest frontier position
+                    uint64_t best = NONE;
+                    for (auto e = g.inEdgesBegin(v); e != g.inEdgesEnd(v); ++e) {
+                        uint32_t u = g.inEdgeSource(e);
+                        if (depth[u] == level)
+                            best = min(best, uint64_t(position[u]) << 32 | g.inEdgeId(e));
+                    }
+                    if (best != NONE) {
+                        parent[v].store(best, memory_order_relaxed);
+                        found[worker].push_back(v);
+                    }
+                }
+            });
+        }
+
+        // counting sort of the new vertices by parent position, then by edge id
+        start.assign(frontier.size() + 1, 0);
+        for (const auto& list : found) {
+            for (uint32_t v : list)
+                start[(parent[v].load(memory_order_relaxed) >> 32) + 1]++;
+        }
+        for (size_t i = 0; i < frontier.size(); i++)
+            start[i + 1] += start[i];
+        next.resize(start.back());
+        for (const auto& list : found) {
+            for (uint32_t v : list)
+                next[start[parent[v].load(memory_order_relaxed) >> 32]++] = v;
+        }
+        auto byEdge = [&](uint32_t a, uint32_t b) {
+            return parent[a].load(memory_order_relaxed) < parent[b].load(memory_order_relaxed);
+        };
+        for (size_t i = 0, first = 0; i < frontier.size(); first = start[i++]) {
+            if (start[i] - first > 1)
+                sort(next.begin() + first, next.begin() + start[i], byEdge);
+        }
+
+        fill(degrees.begin(), degrees.end(), 0);
+        pool.parallelFor(next.size(), [&](size_t lo, size_t hi, unsigned worker) {
+            for (size_t j = lo; j < hi; j++) {
+                uint32_t v = next[j];
+                depth[v] = level + 1;
+                position[v] = j;
+                pre[v] = frontier[parent[v].load(memory_order_relaxed) >> 32];
+                degrees[worker] += g.outDegree(v);
+            }
+        });
+        frontierEdges = 0;
+        for (uint64_t d : degrees)
+            frontierEdges += d;
+        unexploredEdges -= frontierEdges;
+        frontier.swap(next);
+    }
+
+    // copy into the context by whole 64-vertex blocks, since vertices
+    // in one block share a word of the settled bitset
+    ctx.reset(n, s);
+    pool.parallelFor((n + 63) / 64, [&](size_t lo, size_t hi, unsigned) {
+        for (size_t v = lo * 64; v < min<size_t>(hi * 64, n); v++) {
+            if (depth[v] == UNSEEN)
+                continue;
+            ctx.setColor(v, 'b');
+            ctx.setDist(v, depth[v]);
+            ctx.setPre(v, pre[v]);
+        }
+    });
+}
+
+//=================================================================
+// depthFirstVisit
+// Visits every vertex reachable from root that is still white. An
+//   explicit stack of (vertex, next out-edge) frames stands in for
+//   recursion, so long paths cannot overflow the call stack; times
+//   and predecessors are the same as the recursive visit.
+// Parameters:  g - graph to search
+//              root - index of the first vertex to visit
+//              time - the current time counter
+//              ctx - receives colors, predecessors and times
+//              visitor - notified of discoveries, finishes and edges
+//              stack - frame storage, empty on entry and on return
+// Returns:     none
+//=================================================================
+template <class G, class V>
+void depthFirstVisit ( const G& g, uint32_t root, int& time, SearchContext& ctx, V& visitor,
+                       vector<pair<uint32_t, typename G::EdgeIterator>>& stack )
+{
+    auto discover = [&](uint32_t u) {
+        time++;
+        ctx.setDTime(u, time);
+        ctx.setColor(u, 'g');
+        visitor.onDiscover(u, time);
+        stack.push_back(make_pair(u, g.edgesBegin(u)));
+    };
+
+    discover(root);
+    while (!stack.empty()) {
+        uint32_t u = stack.back().first;
+        auto& cursor = stack.back().second;
+        if (cursor == g.edgesEnd(u)) {
+            stack.pop_back();
+            ctx.setColor(u, 'b');
+            time++;
+            ctx.setFTime(u, time);
+            visitor.onFinish(u, time);
+            continue;
+        }
+        uint32_t v = g.edgeTarget(cursor);
+        ++cursor;
+        char color = ctx.getColor(v);
+        visitor.onEdge(u, v, color);
+        if (color == 'w') {
+            ctx.setPre(v, u);
+            discover(v);
+        }
+    }
+}
+
+//=================================================================
+// depthFirstSearch
+// Performs Depth-First Search on the whole graph, starting new
+//   trees in vertex index order
+// Parameters:  g - graph to search
+//              ctx - receives colors, predecessors and times
+// Returns:     none
+//=================================================================
+template <class G>
+void depthFirstSearch ( const G& g, SearchContext& ctx )
+{
+    DFSVisitor none;
+    depthFirstSearch(g, ctx, none);
+}
+
+//=================================================================
+// depthFirstSearch
+// Same as above, reporting the search to a visitor as it happens
+// Parameters:  g - graph to search
+//              ctx - receives colors, predecessors and times
+//              visitor - see DFSVisitor
+// Returns:     none
+//=================================================================
+template <class G, class V>
+void depthFirstSearch ( const G& g, SearchContext& ctx, V& visitor )
+{
+    ctx.reset(g.numVertices());
+    vector<pair<uint32_t, typename G::EdgeIterator>> stack;
+    int time = 0;
+    for (uint32_t u = 0; u < g.numVertices(); u++) {
+        if (ctx.getColor(u) == 'w')
+            depthFirstVisit(g, u, time, ctx, visitor, stack);
+    }
+}
+
+//=================================================================
+// kahnTopologicalSort
+// Orders the vertices so every edge points forward, in O(V+E), by
+//   repeatedly removing vertices with no remaining in-edges. The
+//   vertices removed together form a wavefront: wavefront 0 has no
+//   in-edges at all and every vertex of wavefront k+1 has an
+//   in-edge from wavefront k, so the vertices of one wavefront do
+//   not depend on each other. Each wavefront is in index order,
+//   put there by indexOrderWavefronts rather than by sorting.
+// Parameters:  g - graph to sort
+//              order - receives the vertex indices, wavefront by wavefront
+//              levels - receives the start of each wavefront in order,
+//                       followed by order.size()
+// Returns:     true if every vertex was ordered, false if the graph has
+//              a cycle (order then holds only the vertices before it)
+//=================================================================
+template <class G>
+bool kahnTopologicalSort ( const G& g, vector<uint32_t>& order, vector<uint32_t>& levels )
+{
+    uint32_t n = g.numVertices();
+    vector<uint32_t> indegree(n, 0);
+    for (uint32_t u = 0; u < n; u++) {
+        for (auto e = g.edgesBegin(u); e != g.edgesEnd(u); ++e)
+            indegree[g.edgeTarget(e)]++;
+    }
+
+    vector<uint32_t> level(n, NO_VERTEX);   // wavefront of each ordered vertex
+    order.clear();
+    for (uint32_t u = 0; u < n; u++) {
+        if (indegree[u] == 0) {
+            order.push_back(u);
+            level[u] = 0;
+        }
+    }
+    levels.assign(1, 0);
+    while (levels.back() < order.size()) {
+        size_t begin = levels.back();
+        size_t end = order.size();
+        levels.push_back(end);
+        uint32_t wave = levels.size() - 1;
+        for (size_t i = begin; i < end; i++) {
+            for (auto e = g.edgesBegin(order[i]); e != g.edgesEnd(order[i]); ++e) {
+                uint32_t v = g.edgeTarget(e);
+                if (--indegree[v] == 0) {
+                    order.push_back(v);
+                    level[v] = wave;
+                }
+            }
+        }
+    }
+    indexOrderWavefronts(order, levels, level);
+    return order.size() == n;
+}
+
+//=================================================================
+// indexOrderWavefronts
+// Puts each wavefront of a Kahn order in index order with one pass
+//   over the vertices (a counting sort by wavefront), so ordering
+//   costs O(V) in total instead of a comparison sort per wavefront
+// Parameters:  order - the wavefronts, each in any order
+//              levels - the start of each wavefront in order,
+//                       followed by order.size()
+//              level - wavefront of each vertex index, NO_VERTEX for
+//                      vertices not in order
+// Returns:     none
+//=================================================================
+inline void indexOrderWavefronts ( vector<uint32_t>& order, const vector<uint32_t>& levels, const vector<uint32_t>& level )
+{
+    vector<uint32_t> next(levels.begin(), levels.end() - 1);
+    for (uint32_t u = 0; u < level.size(); u++) {
+        if (level[u] != NO_VERTEX)
+            order[next[level[u]]++] = u;
+    }
+}
+
+//=================================================================
+// parallelKahnTopologicalSort
+// Same result as kahnTopologicalSort, with each wavefront processed
+//   on all threads of the pool. In-degrees are decremented
+//   atomically; the thread that takes one to zero claims the vertex
+//   and records its wavefront, and the per-thread lists are
+//   appended as they are. indexOrderWavefronts then fixes the order
+//   within each wavefront in one O(V) pass.
+// Parameters:  g - graph to sort
+//              order - receives the vertex indices, wavefront by wavefront
+//              levels - receives the start of each wavefront in order,
+//                       followed by order.size()
+//              pool - threads to run on
+// Returns:     true if every vertex was ordered, false on a cycle
+//=================================================================
+template <class G>
+bool parallelKahnTopologicalSort ( const G& g, vector<uint32_t>& order, vector<uint32_t>& levels, ThreadPool& pool )
+{
+    uint32_t n = g.numVertices();
+    vector<atomic<uint32_t>> indegree(n);
+    pool.parallelFor(n, [&](size_t lo, size_t hi, unsigned) {
+        for (size_t u = lo; u < hi; u++)
+            indegree[u].store(0, memory_order_relaxed);
+    });
+    pool.parallelFor(n, [&](size_t lo, size_t hi, unsigned) {
+        for (size_t u = lo; u < hi; u++) {
+            for (auto e = g.edgesBegin(u); e != g.edgesEnd(u); ++e)
+                indegree[g.edgeTarget(e)].fetch_add(1, memory_order_relaxed);
+        }
+    });
+
+    vector<vector<uint32_t>> found(pool.size());
+    auto gather = [&]() {
+        for (auto& list : found) {
+            order.insert(order.end(), list.begin(), list.end());
+            list.clear();
+        }
+    };
+
+    // each vertex is claimed by one thread, which alone writes its level
+    vector<uint32_t> level(n, NO_VERTEX);
+    order.clear();
+    pool.parallelFor(n, [&](size_t lo, size_t hi, unsigned worker) {
+        for (size_t u = lo; u < hi; u++) {
+            if (indegree[u].load(memory_order_relaxed) == 0) {
+                found[worker].push_back(u);
+                level[u] = 0;
+            }
+        }
+    });
+    gather();
+    levels.assign(1, 0);
+    while (levels.back() < order.size()) {
+        size_t begin = levels.back();
+        size_t end = order.size();
+        levels.push_back(end);
+        uint32_t wave = levels.size() - 1;
+        pool.parallelFor(end - begin, [&](size_t lo, size_t hi, unsigned worker) {
+            for (size_t i = begin + lo; i < begin + hi; i++) {
+                for (auto e = g.edgesBegin(order[i]); e != g.edgesEnd(order[i]); ++e) {
+                    uint32_t v = g.edgeTarget(e);
+                    if (indegree[v].fetch_sub(1, memory_order_relaxed) == 1) {
+                        found[worker].push_back(v);
+                        level[v] = wave;
+                    }
+                }
+            }
+        });
+        gather();
+    }
+    indexOrderWavefronts(order, levels, level);
+    return order.size() == n;
+}
+
+//=================================================================
+// findCycle
+// Finds a cycle among the vertices a topological sort left out.
+//   Each of them still has an in-edge from another left-out vertex,
+//   so walking those in-edges backward must come back around.
+// Parameters:  g - graph that was sorted
+//              order - the partial order from kahnTopologicalSort
+// Returns:     vertex indices of a cycle, each with an edge to the
+//              next and the last with an edge to the first; empty if
+//              every vertex was ordered
+//=================================================================
+template <class G>
+vector<uint32_t> findCycle ( const G& g, const vector<uint32_t>& order )
+{
+    uint32_t n = g.numVertices();
+    vector<uint32_t> step(n, NO_VERTEX);   // position on the walk, NO_VERTEX if not walked
+    vector<char> ordered(n, 0);
+    for (uint32_t u : order)
+        ordered[u] = 1;
+
+    uint32_t start = 0;
+    while (start < n && ordered[start])
+        start++;
+    if (start == n)
+        return vector<uint32_t>();
+
+    vector<uint32_t> walk;
+    uint32_t v = start;
+    while (step[v] == NO_VERTEX) {
+        step[v] = walk.size();
+        walk.push_back(v);
+        for (auto e = g.inEdgesBegin(v); e != g.inEdgesEnd(v); ++e) {
+            if (!ordered[g.inEdgeSource(e)]) {
+                v = g.inEdgeSource(e);
+                break;
+            }
+        }
+    }
+    vector<uint32_t> cycle(walk.begin() + step[v], walk.end());
+    reverse(cycle.begin(), cycle.end());
+    return cycle;
+}
+
+//=================================================================
+// requireAcyclic
+// Throws if a topological sort left vertices out, naming a cycle
+//   by its keys (needs g.keyAt)
+// Parameters:  g - graph that was sorted
+//              order - the order from kahnTopologicalSort
+//              where - name of the calling method for the message
+// Returns:     none
+//=================================================================
+template <class G>
+void requireAcyclic ( const G& g, const vector<uint32_t>& order, const string& where )
+{
+    if (order.size() == g.numVertices())
+        return;
+    vector<uint32_t> cycle = findCycle(g, order);
+    stringstream ss;
+    ss << "Error in " << where << ": Graph has a cycle ";
+    for (uint32_t u : cycle)
+        ss << g.keyAt(u) << "->";
+    ss << g.keyAt(cycle[0]);
+    throw invalid_argument(ss.str());
+}
+
+//=================================================================
+// dijkstraSearch
+// Computes single source shortest paths with non-negative weights.
+//   Every vertex is in the heap at most once and improvements use
+//   decrease-key, so this is O((V+E) log V) with no stale entries.
+//   Equal distances leave the heap in index order, which fixes the
+//   predecessor chosen among equally short paths.
+// Parameters:  g - graph to search
+//              s - index of the source vertex
+//              ctx - receives distances and predecessors;
+//                    settled vertices are marked in its bitset
+// Returns:     none
+//=================================================================
+template <class G>
+void dijkstraSearch ( const G& g, uint32_t s, SearchContext& ctx )
+{
+    NoStats none;
+    dijkstraSearch(g, s, ctx, none);
+}
+
+//=================================================================
+// dijkstraSearch
+// Same as above, counting the work in stats (see search_stats.h)
+// Parameters:  g - graph to search
+//              s - index of the source vertex
+//              ctx - receives distances and predecessors;
+//                    settled vertices are marked in its bitset
+//              stats - stats policy, NoStats or QueryStats
+// Returns:     none
+//=================================================================
+template <class G, class S>
+void dijkstraSearch ( const G& g, uint32_t s, SearchContext& ctx, S& stats )
+{
+    stats.phase(SearchPhase::Initialize);
+    ctx.reset(g.numVertices(), s);
+    ctx.setDist(s, 0);
+
+    IndexedHeap<double>& q = ctx.heap();
+    q.clear();
+    q.push(s, 0);
+    stats.pushed();
+    stats.phase(SearchPhase::Search);
+    while (!q.empty()) {
+        uint32_t u = q.pop();
+        stats.popped();
+        double du = ctx.getDist(u);
+        ctx.setSettled(u);
+        stats.settled();
+
+        for (auto e = g.edgesBegin(u); e != g.edgesEnd(u); ++e) {
+            uint32_t v = g.edgeTarget(e);
+            double dv = du + g.edgeWeight(e);
+            double old = ctx.getDist(v);
+            stats.scanned();
+            if (dv < old && !ctx.isSettled(v)) {
+                ctx.setDist(v, dv);
+                ctx.setPre(v, u);
+                q.push(v, dv);
+                stats.relaxed();
+                // a vertex with a finite distance is already queued
+                if (old == SearchContext::INF)
+                    stats.pushed();
+                else
+                    stats.decreased();
+            }
+        }
+    }
+    stats.finish();
+}
+
+//=================================================================
+// dijkstraToTargets
+// dijkstraSearch that stops once every target is settled, so a
+//   nearby set of targets costs only the ball around s that holds
+//   them. Distances of settled vertices are final; others may not be.
+// Parameters:  g - graph to search
+//              s - index of the source vertex
+//              isTarget - nonzero for each target vertex index
+//              numTargets - number of nonzero entries in isTarget
+//              ctx - receives distances and predecessors
+// Returns:     none
+//=================================================================
+template <class G>
+void dijkstraToTargets ( const G& g, uint32_t s, const vector<char>& isTarget, uint32_t numTargets, SearchContext& ctx )
+{
+    ctx.reset(g.numVertices(), s);
+    ctx.setDist(s, 0);
+
+    IndexedHeap<double>& q = ctx.heap();
+    q.clear();
+    q.push(s, 0);
+    uint32_t remaining = numTargets;
+    while (!q.empty() && remaining > 0) {
+        uint32_t u = q.pop();
+        double du = ctx.getDist(u);
+        ctx.setSettled(u);
+        if (isTarget[u])
+            remaining--;
+
+        for (auto e = g.edgesBegin(u); e != g.edgesEnd(u); ++e) {
+            uint32_t v = g.edgeTarget(e);
+            double dv = du + g.edgeWeight(e);
+            if (dv < ctx.getDist(v) && !ctx.isSettled(v)) {
+                ctx.setDist(v, dv);
+                ctx.setPre(v, u);
+                q.push(v, dv);
+            }
+        }
+    }
+    q.clear();
+}
+
+//=================================================================
+// distanceTableSearch
+// Shortest weighted distances from every source to every target:
+//   one dijkstraToTargets per source, sources spread over the pool
+//   with each thread searching in its own SearchContext::local(0)
+// Parameters:  g - graph to search
+//              sources - source vertex indices, one row each
+//              targets - target vertex indices, one column each
+//              pool - threads to run on
+// Returns:     sources.size() x targets.size() matrix of distances,
+//              INF where a target cannot be reached
+//=================================================================
+template <class G>
+Matrix<double> distanceTableSearch ( const G& g, const vector<uint32_t>& sources, const vector<uint32_t>& targets, ThreadPool& pool )
+{
+    vector<char> isTarget(g.numVertices(), 0);
+    uint32_t numTargets = 0;
+    for (uint32_t t : targets) {
+        if (!isTarget[t]) {
+            isTarget[t] = 1;
+            numTargets++;
+        }
+    }
+
+    Matrix<double> table(sources.size(), targets.size(), SearchContext::INF);
+    pool.parallelFor(sources.size(), [&](size_t begin, size_t end, unsigned) {
+        SearchContext& ctx = SearchContext::local(0);
+        for (size_t i = begin; i < end; i++) {
+            dijkstraToTargets(g, sources[i], isTarget, numTargets, ctx);
+            double* row = table.row(i);
+            for (size_t j = 0; j < targets.size(); j++)
+                row[j] = ctx.getDist(targets[j]);
+        }
+    }, 1);
+    return table;
+}
+
+//=================================================================
+// deltaSteppingSearch
+// Parallel single source shortest paths with non-negative weights.
+//   Tentative distances are kept in buckets of width delta. The
+//   lowest bucket is emptied by relaxing the light edges (weight
+//   <= delta) of its vertices in parallel, repeatedly, since they
+//   can refill it; then the heavy edges of everything it held are
+//   relaxed once. Distances are lowered with an atomic min.
+//   The distances are those dijkstraSearch computes. Predecessors
+//   are rebuilt afterwards by canonicalPredecessors, so ctx ends
+//   up exactly as dijkstraSearch leaves it.
+// Parameters:  g - graph to search
+//              s - index of the source vertex
+//              ctx - receives distances and predecessors
+//              pool - threads to run on
+//              delta - bucket width; <= 0 picks the mean edge weight
+// Returns:     none
+//=================================================================
+template <class G>
+void deltaSteppingSearch ( const G& g, uint32_t s, SearchContext& ctx, ThreadPool& pool, double delta )
+{
+    const uint64_t NONE = UINT64_MAX;
+    uint32_t n = g.numVertices();
+
+    if (delta <= 0) {
+        vector<double> sums(pool.size(), 0);
+        vector<uint64_t> counts(pool.size(), 0);
+        pool.parallelFor(n, [&](size_t lo, size_t hi, unsigned worker) {
+            for (size_t u = lo; u < hi; u++) {
+                for (auto e = g.edgesBegin(u); e != g.edgesEnd(u); ++e) {
+                    sums[worker] += g.edgeWeight(e);
+                    counts[worker]++;
+                }
+            }
+        });
+        double sum = 0;
+        uint64_t count = 0;
+        for (unsigned w = 0; w < pool.size(); w++) {
+            sum += sums[w];
+            count += counts[w];
+        }
+        delta = count > 0 && sum > 0 ? sum / count : 1;
+    }
+
+    vector<atomic<double>> dist(n);
+    vector<uint64_t> slot(n, NONE);   // bucket v was last filed under, NONE once taken out
+    pool.parallelFor(n, [&](size_t lo, size_t hi, unsigned) {
+        for (size_t v = lo; v < hi; v++)
+            dist[v].store(SearchContext::INF, memory_order_relaxed);
+    });
+
+    map<uint64_t, vector<uint32_t>> buckets;
+    vector<vector<uint32_t>> improved(pool.size());
+    auto bucketOf = [&](uint32_t v) { return uint64_t(dist[v].load(memory_order_relaxed) / delta); };
+    auto file = [&]() {
+        for (auto& list : improved) {
+            for (uint32_t v : list) {
+                uint64_t b = bucketOf(v);
+                if (slot[v] != b) {
+                    slot[v] = b;
+                    buckets[b].push_back(v);
+                }
+            }
+            list.clear();
+        }
+    };
+    auto relax = [&](const vector<uint32_t>& from, bool light) {
+        pool.parallelFor(from.size(), [&](size_t lo, size_t hi, unsigned worker) {
+            for (size_t i = lo; i < hi; i++) {
+                uint32_t u = from[i];
+                double du = dist[u].load(memory_order_relaxed);
+                for (auto e = g.edgesBegin(u); e != g.edgesEnd(u); ++e) {
+                    double w = g.edgeWeight(e);
+                    if ((w <= delta) != light)
+                        continue;
+                    uint32_t v = g.edgeTarget(e);
+                    double dv = du + w;
+                    double old = dist[v].load(memory_order_relaxed);
+                    while (dv < old && !dist[v].compare_exchange_weak(old, dv, memory_order_relaxed)) { }
+                    if (dv < old)
+                        improved[worker].push_back(v);
+                }
+            }
+        });
+    };
+
+    dist[s].store(0, memory_order_relaxed);
+    improved[0].push_back(s);
+    file();
+    vector<uint32_t> current;
+    vector<uint32_t> emptied;
+    while (!buckets.empty()) {
+        uint64_t i = buckets.begin()->first;
+        emptied.clear();
+        while (buckets.count(i)) {
+            current.clear();
+            for (uint32_t v : buckets[i]) {
+                if (slot[v] == i) {
+                    slot[v] = NONE;
+                    current.push_back(v);
+                }
+            }
+            buckets.erase(i);
+            emptied.insert(emptied.end(), current.begin(), current.end());
+            relax(current, true);
+            file();
+        }
+        sort(emptied.begin(), emptied.end());
+        emptied.erase(unique(emptied.begin(), emptied.end()), emptied.end());
+        relax(emptied, false);
+        file();
+    }
+
+    vector<double> final(n);
+    pool.parallelFor(n, [&](size_t lo, size_t hi, unsigned) {
+        for (size_t v = lo; v < hi; v++)
+            final[v] = dist[v].load(memory_order_relaxed);
+    });
+    canonicalPredecessors(g, s, final, ctx, pool);
+}
+
+//=================================================================
+// canonicalPredecessors
+// Fills ctx with the given final distances and the predecessors
+//   dijkstraSearch would pick. dijkstraSearch settles vertices by
+//   distance, and among equal distances pops the lowest index that
+//   is in the heap; a vertex enters the heap at its final distance
+//   once its first tight in-neighbor (dist[u] + w == dist[v]) is
+//   settled, and that neighbor stays its predecessor. The settle
+//   order is replayed from the distances alone, then every vertex
+//   takes its earliest settled tight in-neighbor.
+// Parameters:  g - graph searched
+//              s - index of the source vertex
+//              dist - final distances, infinity if unreached
+//              ctx - receives distances and predecessors
+//              pool - threads to run on
+// Returns:     none
+//=================================================================
+template <class G>
+void canonicalPredecessors ( const G& g, uint32_t s, const vector<double>& dist, SearchContext& ctx, ThreadPool& pool )
+{
+    uint32_t n = g.numVertices();
+    vector<vector<uint32_t>> lists(pool.size());
+    pool.parallelFor(n, [&](size_t lo, size_t hi, unsigned worker) {
+        for (size_t v = lo; v < hi; v++) {
+            if (dist[v] != SearchContext::INF)
+                lists[worker].push_back(v);
+        }
+    });
+    vector<uint32_t> order;
+    for (const auto& list : lists)
+        order.insert(order.end(), list.begin(), list.end());
+    sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return dist[a] < dist[b] || (dist[a] == dist[b] && a < b);
+    });
+
+    // runs of equal distance are in index order; replay the heap within
+    // each run, starting from the vertices entered from lower distances
+    vector<pair<size_t, size_t>> runs;
+    for (size_t first = 0, last; first < order.size(); first = last) {
+        for (last = first + 1; last < order.size() && dist[order[last]] == dist[order[first]]; last++) { }
+        if (last - first > 1)
+            runs.push_back(make_pair(first, last));
+    }
+    vector<char> queued(n, 0);
+    pool.parallelFor(runs.size(), [&](size_t lo, size_t hi, unsigned) {
+        vector<uint32_t> replay;
+        for (size_t r = lo; r < hi; r++) {
+            size_t first = runs[r].first;
+            size_t last = runs[r].second;
+            double d = dist[order[first]];
+
+            priority_queue<uint32_t, vector<uint32_t>, greater<uint32_t>> ready;
+            for (size_t i = first; i < last; i++) {
+                uint32_t v = order[i];
+                bool entered = v == s;
+                for (auto e = g.inEdgesBegin(v); e != g.inEdgesEnd(v) && !entered; ++e) {
+                    uint32_t u = g.inEdgeSource(e);
+                    entered = dist[u] < d && dist[u] + g.inEdgeWeight(e) == d;
+                }
+                if (entered) {
+                    queued[v] = 1;
+                    ready.push(v);
+                }
+            }
+            replay.clear();
+            while (!ready.empty()) {
+                uint32_t u = ready.top();
+                ready.pop();
+                replay.push_back(u);
+                for (auto e = g.edgesBegin(u); e != g.edgesEnd(u); ++e) {
+                    uint32_t v = g.edgeTarget(e);
+                    if (dist[v] == d && !queued[v] && d + g.edgeWeight(e) == d) {
+                        queued[v] = 1;
+                        ready.push(v);
+                    }
+                }
+            }
+            copy(replay.begin(), replay.end(), order.begin() + first);
+        }
+    });
+
+    vector<uint32_t> rank(n, NO_VERTEX);
+    pool.parallelFor(order.size(), [&](size_t lo, size_t hi, unsigned) {
+        for (size_t i = lo; i < hi; i++)
+            rank[order[i]] = i;
+    });
+
+    // written by whole 64-vertex blocks, which share a word of the settled bitset
+    ctx.reset(n, s);
+    pool.parallelFor((n + 63) / 64, [&](size_t lo, size_t hi, unsigned) {
+        for (size_t v = lo * 64; v < min<size_t>(hi * 64, n); v++) {
+            if (dist[v] == SearchContext::INF)
+                continue;
+            uint32_t pre = NO_VERTEX;
+            for (auto e = g.inEdgesBegin(v); e != g.inEdgesEnd(v); ++e) {
+                uint32_t u = g.inEdgeSource(e);
+                if (rank[u] < rank[v] && dist[u] + g.inEdgeWeight(e) == dist[v] && (pre == NO_VERTEX || rank[u] < rank[pre]))
+                    pre = u;
+            }
+            ctx.setDist(v, dist[v]);
+            ctx.setPre(v, pre);
+            ctx.setSettled(v);
+        }
+    });
+}
+
+//=================================================================
+// haversineDistance
+// Great-circle distance between two (longitude, latitude) points
+// Parameters:  a, b - points in degrees
+// Returns:     distance in meters
+//=================================================================
+inline double haversineDistance ( const tuple<double, double>& a, const tuple<double, double>& b )
+{
+    const double EARTH_RADIUS = 6371008.8;
+    const double RAD = M_PI / 180.0;
+    double lat1 = get<1>(a) * RAD;
+    double lat2 = get<1>(b) * RAD;
+    double dLat = lat2 - lat1;
+    double dLon = (get<0>(b) - get<0>(a)) * RAD;
+    double h = sin(dLat / 2) * sin(dLat / 2) + cos(lat1) * cos(lat2) * sin(dLon / 2) * sin(dLon / 2);
+    return 2 * EARTH_RADIUS * asin(sqrt(min(1.0, h)));
+}
+
+//=================================================================
+// astarSearch
+// Point-to-point shortest path guided by the straight-line distance
+//   to t. The estimate is the great-circle distance scaled by
+//   g.heuristicScale(), which never overestimates and obeys the
+//   triangle inequality, so a vertex is final when it leaves the
+//   heap and the search stops as soon as t does.
+// Parameters:  g - graph to search
+//              s - index of the source vertex
+//              t - index of the target vertex
+//              ctx - receives distances and predecessors of the
+//                    vertices the search touched
+// Returns:     true if t is reachable from s
+//=================================================================
+template <class G>
+bool astarSearch ( const G& g, uint32_t s, uint32_t t, SearchContext& ctx )
+{
+    ctx.reset(g.numVertices(), s);
+    ctx.setDist(s, 0);
+
+    const tuple<double, double>& target = g.vertexData(t);
+    double scale = g.heuristicScale();
+    auto estimate = [&](uint32_t v) {
+        return scale * haversineDistance(g.vertexData(v), target);
+    };
+
+    IndexedHeap<double>& q = ctx.heap();
+    q.clear();
+    q.push(s, estimate(s));
+    while (!q.empty()) {
+        uint32_t u = q.pop();
+        ctx.setSettled(u);
+        if (u == t) {
+            q.clear();
+            return true;
+        }
+        double du = ctx.getDist(u);
+
+        for (auto e = g.edgesBegin(u); e != g.edgesEnd(u); ++e) {
+            uint32_t v = g.edgeTarget(e);
+            double dv = du + g.edgeWeight(e);
+            if (dv < ctx.getDist(v) && !ctx.isSettled(v)) {
+                ctx.setDist(v, dv);
+                ctx.setPre(v, u);
+                q.push(v, dv + estimate(v));
+            }
+        }
+    }
+    return false;
+}
+
+//=================================================================
+// joinBidirectional
+// Extends the forward predecessor chain s -> meet with the backward
+//   chain meet -> t, so fwd holds a complete s -> t path afterwards.
+//   In the backward search the predecessor of x is the next vertex
+//   from x toward t. If the two chains share a vertex (possible
+//   only with zero-weight cycles) the path takes the forward chain
+//   up to it, so the result never loops. The forward chain is kept
+//   sorted in fwd's scratch list; colors are left as the search set
+//   them.
+// Parameters:  g - graph searched
+//              meet - vertex reached by both searches
+//              t - target vertex index
+//              fwd - forward context, receives the joined chain
+//              bwd - backward context
+// Returns:     none
+//=================================================================
+template <class G>
+void joinBidirectional ( const G& g, uint32_t meet, uint32_t t, SearchContext& fwd, const SearchContext& bwd )
+{
+    vector<uint32_t>& chain = fwd.scratch();
+    chain.clear();
+    for (uint32_t x = meet; x != NO_VERTEX; x = fwd.getPre(x))
+        chain.push_back(x);
+    sort(chain.begin(), chain.end());
+
+    for (uint32_t cur = meet; cur != t; ) {
+        uint32_t next = bwd.getPre(cur);
+        if (!binary_search(chain.begin(), chain.end(), next)) {
+            double w = SearchContext::INF;
+            for (auto e = g.edgesBegin(cur); e != g.edgesEnd(cur); ++e) {
+                if (g.edgeTarget(e) == next)
+                    w = min(w, g.edgeWeight(e));
+            }
+            fwd.setDist(next, fwd.getDist(cur) + w);
+            fwd.setPre(next, cur);
+        }
+        cur = next;
+    }
+}
+
+//=================================================================
+// bidirectionalBFS
+// Fewest-edges path from s to t. Each round expands one whole BFS
+//   level of whichever side has the smaller frontier. If the forward
+//   ball of radius kF-1 and the backward ball of radius kB are
+//   disjoint, every s-t path has at least kF + kB edges, so the
+//   first vertex discovered by both sides lies on a shortest path
+//   and the search stops there.
+// Parameters:  g - graph to search
+//              s - index of the source vertex
+//              t - index of the target vertex
+//              fwd - forward context, receives the s -> t path
+//              bwd - backward context
+// Returns:     true if t is reachable from s
+//=================================================================
+template <class G>
+bool bidirectionalBFS ( const G& g, uint32_t s, uint32_t t, SearchContext& fwd, SearchContext& bwd )
+{
+    fwd.reset(g.numVertices(), s);
+    bwd.reset(g.numVertices(), t);
+    fwd.setColor(s, 'g');
+    fwd.setDist(s, 0);
+    bwd.setColor(t, 'g');
+    bwd.setDist(t, 0);
+    if (s == t)
+        return true;
+
+    // each queue holds its levels back to back; [head, size) is the frontier
+    vector<uint32_t>& qf = fwd.scratch();
+    vector<uint32_t>& qb = bwd.scratch();
+    qf.assign(1, s);
+    qb.assign(1, t);
+    size_t fHead = 0;
+    size_t bHead = 0;
+    uint32_t meet = NO_VERTEX;
+
+    while (meet == NO_VERTEX && fHead < qf.size() && bHead < qb.size()) {
+        if (qf.size() - fHead <= qb.size() - bHead) {
+            for (size_t end = qf.size(); fHead < end && meet == NO_VERTEX; fHead++) {
+                uint32_t u = qf[fHead];
+                for (auto e = g.edgesBegin(u); e != g.edgesEnd(u); ++e) {
+                    uint32_t v = g.edgeTarget(e);
+                    if (fwd.getColor(v) != 'w')
+                        continue;
+                    fwd.setColor(v, 'g');
+                    fwd.setDist(v, fwd.getDist(u) + 1);
+                    fwd.setPre(v, u);
+                    qf.push_back(v);
+                    if (bwd.getColor(v) != 'w') {
+                        meet = v;
+                        break;
+                    }
+                }
+            }
+        } else {
+            for (size_t end = qb.size(); bHead < end && meet == NO_VERTEX; bHead++) {
+                uint32_t u = qb[bHead];
+                for (auto e = g.inEdgesBegin(u); e != g.inEdgesEnd(u); ++e) {
+                    uint32_t v = g.inEdgeSource(e);
+                    if (bwd.getColor(v) != 'w')
+                        continue;
+                    bwd.setColor(v, 'g');
+                    bwd.setDist(v, bwd.getDist(u) + 1);
+                    bwd.setPre(v, u);
+                    qb.push_back(v);
+                    if (fwd.getColor(v) != 'w') {
+                        meet = v;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    if (meet == NO_VERTEX)
+        return false;
+    joinBidirectional(g, meet, t, fwd, bwd);
+    return true;
+}
+
+//=================================================================
+// bidirectionalDijkstra
+// Shortest weighted path from s to t, alternating between a forward
+//   dijkstra from s and a backward dijkstra from t over the in-edges,
+//   always advancing the side with the smaller heap minimum. best is
+//   the shortest s-t distance through any vertex labeled by both
+//   sides; once the two heap minima add up to at least best, no
+//   unexplored path can be shorter.
+// Parameters:  g - graph to search
+//              s - index of the source vertex
+//              t - index of the target vertex
+//              fwd - forward context, receives the s -> t path
+//              bwd - backward context
+// Returns:     true if t is reachable from s
+//=================================================================
+template <class G>
+bool bidirectionalDijkstra ( const G& g, uint32_t s, uint32_t t, SearchContext& fwd, SearchContext& bwd )
+{
+    fwd.reset(g.numVertices(), s);
+    bwd.reset(g.numVertices(), t);
+    fwd.setDist(s, 0);
+    bwd.setDist(t, 0);
+    if (s == t)
+        return true;
+
+    IndexedHeap<double>& qf = fwd.heap();
+    IndexedHeap<double>& qb = bwd.heap();
+    qf.clear();
+    qb.clear();
+    qf.push(s, 0);
+    qb.push(t, 0);
+    double best = SearchContext::INF;
+    uint32_t meet = NO_VERTEX;
+
+    while (!qf.empty() && !qb.empty() && qf.topPriority() + qb.topPriority() < best) {
+        if (qf.topPriority() <= qb.topPriority()) {
+            uint32_t u = qf.pop();
+            double du = fwd.getDist(u);
+            fwd.setSettled(u);
+            for (auto e = g.edgesBegin(u); e != g.edgesEnd(u); ++e) {
+                uint32_t v = g.edgeTarget(e);
+                double dv = du + g.edgeWeight(e);
+                if (dv < fwd.getDist(v) && !fwd.isSettled(v)) {
+                    fwd.setDist(v, dv);
+                    fwd.setPre(v, u);
+                    qf.push(v, dv);
+                    if (dv + bwd.getDist(v) < best) {
+                        best = dv + bwd.getDist(v);
+                        meet = v;
+                    }
+                }
+            }
+        } else {
+            uint32_t u = qb.pop();
+            double du = bwd.getDist(u);
+            bwd.setSettled(u);
+            for (auto e = g.inEdgesBegin(u); e != g.inEdgesEnd(u); ++e) {
+                uint32_t v = g.inEdgeSource(e);
+                double dv = du + g.inEdgeWeight(e);
+                if (dv < bwd.getDist(v) && !bwd.isSettled(v)) {
+                    bwd.setDist(v, dv);
+                    bwd.setPre(v, u);
+                    qb.push(v, dv);
+                    if (dv + fwd.getDist(v) < best) {
+                        best = dv + fwd.getDist(v);
+                        meet = v;
+                    }
+                }
+            }
+        }
+    }
+    qf.clear();
+    qb.clear();
+
+    if (meet == NO_VERTEX)
+        return false;
+    joinBidirectional(g, meet, t, fwd, bwd);
+    return true;
+}
@@ -0,0 +1,132 @@
+//=================================================================
+// CS 271 - Project 6
+// graph_search.h
+// Fall 2025
+// This is the declaration file for the search algorithms shared by
+// Graph and CompactGraph
+//=================================================================
+
+#ifndef GRAPH_SEARCH_H
+#define GRAPH_SEARCH_H
+
+#include <vector>
+#include <cstdint>
+#include <tuple>
+#include <string>
+#include "search_context.h"
+#include "thread_pool.h"
+#include "matrix.h"
+#include "search_stats.h"
+using namespace std;
+
+// The algorithms below work on any graph type G that provides
+//   uint32_t     numVertices ( ) const;
+//   EdgeIterator edgesBegin  ( uint32_t u ) const;
+//   EdgeIterator edgesEnd    ( uint32_t u ) const;
+//   uint32_t     edgeTarget  ( EdgeIterator e ) const;
+//   double       edgeWeight  ( EdgeIterator e ) const;
+// where EdgeIterator walks the out-edges of u and is exported as
+// G::EdgeIterator. The graph is only read; all results are written
+// to the SearchContext.
+// Bidirectional searches additionally walk in-edges with
+//   InEdgeIterator inEdgesBegin ( uint32_t v ) const;
+//   InEdgeIterator inEdgesEnd   ( uint32_t v ) const;
+//   uint32_t       inEdgeSource ( InEdgeIterator e ) const;
+//   double         inEdgeWeight ( InEdgeIterator e ) const;
+// Delta-stepping and findCycle also walk in-edges.
+// The parallel BFS additionally needs
+//   uint32_t numEdges  ( ) const;
+//   uint32_t outDegree ( uint32_t u ) const;
+//   uint32_t edgeId    ( EdgeIterator e ) const;
+//   uint32_t inEdgeId  ( InEdgeIterator e ) const;
+// where edge ids are below numEdges and increase along the out-edges
+// of each vertex, and inEdgeId gives the id of the same edge seen
+// from its source.
+// requireAcyclic also needs
+//   const K& keyAt ( uint32_t u ) const;
+// A* additionally needs
+//   tuple<double, double> vertexData     ( uint32_t u ) const;   // or a const reference to one
+//   double                heuristicScale ( ) const;
+// where vertexData is (longitude, latitude) in degrees and every edge
+// weighs at least heuristicScale times its great-circle length.
+
+// Receives the events of a depth-first search as they happen. Any
+// class with these three members can be passed instead; this one
+// ignores everything. onDiscover and onFinish get a vertex and its
+// time; onEdge(u, v, color) gets an edge and the color of v before
+// the edge is followed: 'w' for a tree edge, 'g' for a back edge (a
+// cycle) and 'b' for a forward or cross edge.
+struct DFSVisitor
+{
+   void     onDiscover  ( uint32_t, int ) { }
+   void     onFinish    ( uint32_t, int ) { }
+   void     onEdge      ( uint32_t, uint32_t, char ) { }
+};
+
+template <class G>
+void     breadthFirstSearch ( const G& g, uint32_t s, SearchContext& ctx );
+
+template <class G, class S>
+void     breadthFirstSearch ( const G& g, uint32_t s, SearchContext& ctx, S& stats );
+
+template <class G>
+void     parallelBreadthFirstSearch ( const G& g, uint32_t s, SearchContext& ctx, ThreadPool& pool );
+
+template <class G>
+void     depthFirstSearch   ( const G& g, SearchContext& ctx );
+
+template <class G, class V>
+void     depthFirstSearch   ( const G& g, SearchContext& ctx, V& visitor );
+
+template <class G, class V>
+void     depthFirstVisit    ( const G& g, uint32_t root, int& time, SearchContext& ctx, V& visitor,
+                              vector<pair<uint32_t, typename G::EdgeIterator>>& stack );
+
+template <class G>
+bool     kahnTopologicalSort ( const G& g, vector<uint32_t>& order, vector<uint32_t>& levels );
+
+void     indexOrderWavefronts ( vector<uint32_t>& order, const vector<uint32_t>& levels, const vector<uint32_t>& level );
+
+template <class G>
+bool     parallelKahnTopologicalSort ( const G& g, vector<uint32_t>& order, vector<uint32_t>& levels, ThreadPool& pool );
+
+template <class G>
+vector<uint32_t> findCycle ( const G& g, const vector<uint32_t>& order );
+
+template <class G>
+void     requireAcyclic     ( const G& g, const vector<uint32_t>& order, const string& where );
+
+template <class G>
+void     dijkstraSearch     ( const G& g, uint32_t s, SearchContext& ctx );
+
+template <class G, class S>
+void     dijkstraSearch     ( const G& g, uint32_t s, SearchContext& ctx, S& stats );
+
+template <class G>
+void     deltaSteppingSearch ( const G& g, uint32_t s, SearchContext& ctx, ThreadPool& pool, double delta );
+
+template <class G>
+void     canonicalPredecessors ( const G& g, uint32_t s, const vector<double>& dist, SearchContext& ctx, ThreadPool& pool );
+
+template <class G>
+void     dijkstraToTargets  ( const G& g, uint32_t s, const vector<char>& isTarget, uint32_t numTargets, SearchContext& ctx );
+
+template <class G>
+Matrix<double> distanceTableSearch ( const G& g, const vector<uint32_t>& sources, const vector<uint32_t>& targets, ThreadPool& pool );
+
+template <class G>
+bool     astarSearch        ( const G& g, uint32_t s, uint32_t t, SearchContext& ctx );
+
+template <class G>
+bool     bidirectionalBFS      ( const G& g, uint32_t s, uint32_t t, SearchContext& fwd, SearchContext& bwd );
+
+template <class G>
+bool     bidirectionalDijkstra ( const G& g, uint32_t s, uint32_t t, SearchContext& fwd, SearchContext& bwd );
+
+template <class G>
+void     joinBidirectional     ( const G& g, uint32_t meet, uint32_t t, SearchContext& fwd, const SearchContext& bwd );
+
+double   haversineDistance  ( const tuple<double, double>& a, const tuple<double, double>& b );
+
+#include "graph_search.cpp"
+#endif
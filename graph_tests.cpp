@@ -14,7 +14,12 @@
 #include <climits>
 #include <limits>
 #include "graph.h"
+#include "graph_io.h"
+#include "graph_generator.h"
 #include <tuple>
+#include <thread>
+#include <algorithm>
+#include <random>
 using namespace std;
 
 // helper function to create a graph from a file
@@ -157,7 +162,7 @@ void test_weighted_shortestPath_lengthTen()
 {
     Graph<int, string> g = createGraphFromFile("denison.txt");
     string path = g.shortestPath(73712, 635949, true);
-    string correct_path = "Total distance: 10\n(-82.518332, 40.069045)\nNorth Prospect Street(-82.518329, 40.069083)\nEast College Street(-82.520055, 40.069182)\nPresident's Drive(-82.522614, 40.070549)\nPresident's Drive(-82.522673, 40.070789)\nPresident's Drive(-82.522984, 40.071528)\nRidge Road(-82.523694, 40.071846)\nRidge Road(-82.525078, 40.072356)\nWashington Drive(-82.525146, 40.072547)\nEbaugh Drive(-82.525236, 40.072556)\nEbaugh Drive(-82.525307, 40.072550)\n";
+    string correct_path = "Total distance: 814.396903\n(-82.518332, 40.069045)\nNorth Prospect Street(-82.518329, 40.069083)\nEast College Street(-82.520055, 40.069182)\nPresident's Drive(-82.522614, 40.070549)\nPresident's Drive(-82.522673, 40.070789)\nPresident's Drive(-82.522984, 40.071528)\nRidge Road(-82.523694, 40.071846)\nRidge Road(-82.525078, 40.072356)\nWashington Drive(-82.525146, 40.072547)\nEbaugh Drive(-82.525236, 40.072556)\nEbaugh Drive(-82.525307, 40.072550)\n";
 
     if (path != correct_path) {
         cout << "Shortest path result is incorrect. got: `" << path << "`" << endl;
@@ -337,6 +342,1436 @@ void test_asAdjMatrix_lengthFive()
 }
 
 
+void test_freeze_shortestPath()
+{
+    try{
+        Graph<int, string> g = createGraphFromFile("denison.txt");
+        CompactGraph<int, string> c = g.freeze();
+        if (c.numVertices() != g.numVertices()) {
+            cout << "Compact graph has " << c.numVertices() << " vertices, expected " << g.size() << endl;
+        }
+        int pairs[][2] = {{73712, 635949}, {91442, 70838}, {35429, 615}, {635949, 73712}};
+        for (auto& pair : pairs) {
+            string expected = g.shortestPath(pair[0], pair[1]);
+            string path = c.shortestPath(pair[0], pair[1]);
+            if (path != expected) {
+                cout << "Compact shortest path from " << pair[0] << " to " << pair[1] << " is incorrect. Expected: `" << expected << "` but got: `" << path << "`" << endl;
+            }
+        }
+        if (c.getWeight(91442, 91444) != g.getWeight(91442, 91444)) {
+            cout << "Compact weight of 91442->91444 is incorrect: " << c.getWeight(91442, 91444) << endl;
+        }
+    }
+    catch (std::exception& e) {
+        cerr << "Error testing freeze: " << e.what() << endl;
+    }
+}
+
+void test_freeze_topologicalSort()
+{
+    try{
+        Graph<int, string> g;
+        for (int key : {5, 3, 9, 1, 7})
+            g.insertVertex(key, make_tuple(0.0, 0.0));
+        g.insertEdge(5, 9, 1, "");
+        g.insertEdge(3, 5, 1, "");
+        g.insertEdge(1, 3, 1, "");
+        g.insertEdge(9, 7, 1, "");
+        g.insertEdge(1, 7, 1, "");
+        CompactGraph<int, string> c = g.freeze();
+        string expected = g.topologicalSort();
+        string result = c.topologicalSort();
+        if (result != "1->3->5->9->7" || result != expected) {
+            cout << "Compact topological sort is incorrect. Expected: " << expected << " but got: " << result << endl;
+        }
+    }
+    catch (std::exception& e) {
+        cerr << "Error testing compact topological sort: " << e.what() << endl;
+    }
+}
+
+
+void test_keyIndex()
+{
+    KeyIndex<int> index;
+    // keys far apart and sequential runs, enough to force several rehashes
+    for (uint32_t i = 0; i < 5000; i++) {
+        index.insert(i * 7919 - 20000, i);
+    }
+    if (index.size() != 5000) {
+        cout << "KeyIndex size is incorrect. Expected: 5000 but got: " << index.size() << endl;
+    }
+    if (index.insert(-20000, 42) != 0) {
+        cout << "KeyIndex insert of an existing key should return its old index" << endl;
+    }
+    for (uint32_t i = 0; i < 5000; i++) {
+        if (index.find(i * 7919 - 20000) != i) {
+            cout << "KeyIndex lookup of key " << i * 7919 - 20000 << " is incorrect" << endl;
+            return;
+        }
+    }
+    if (index.find(1) != NO_VERTEX) {
+        cout << "KeyIndex found a key that was never inserted" << endl;
+    }
+}
+
+void test_asAdjMatrix_sparseKeys()
+{
+    try{
+        Graph<int, string> g;
+        g.insertVertex(300, make_tuple(0.0, 0.0));
+        g.insertVertex(-5, make_tuple(0.0, 0.0));
+        g.insertVertex(42, make_tuple(0.0, 0.0));
+        g.insertEdge(300, -5, 7, "");
+        g.insertEdge(-5, 42, 2, "");
+        int** adjMatrix = g.asAdjMatrix();
+        string actualString;
+        for (int i = 0; i < g.size(); ++i) {
+            for (int j = 0; j < g.size(); ++j) {
+                if (adjMatrix[i][j] == INT_MAX)
+                    actualString += "inf ";
+                else
+                actualString += to_string(adjMatrix[i][j]) + " ";
+            }
+            actualString.pop_back(); // remove trailing space
+            actualString += "\n";
+            delete[] adjMatrix[i];
+        }
+        delete[] adjMatrix;
+
+        // rows/columns in key order: -5, 42, 300
+        string expectedString = "inf 2 inf\ninf inf inf\n7 inf inf\n";
+        if (actualString != expectedString) {
+            cout << "Adjacency matrix is incorrect. Expected:\n" << expectedString << "but got:\n" << actualString << endl;
+        }
+    }
+    catch (std::exception& e) {
+        cerr << "Error testing adjacency matrix: " << e.what() << endl;
+    }
+}
+
+void test_searchContext_reuse()
+{
+    try{
+        Graph<int, string> g = createGraphFromFile("denison.txt");
+        SearchContext reused;
+        // the first search leaves vertices that the second cannot reach
+        g.BFS(73712, reused);
+        g.BFS(635949, reused);
+        SearchContext fresh;
+        g.BFS(635949, fresh);
+        for (uint32_t v = 0; v < g.numVertices(); v++) {
+            if (reused.getDist(v) != fresh.getDist(v) || reused.getPre(v) != fresh.getPre(v) || reused.getColor(v) != fresh.getColor(v)) {
+                cout << "Reused search context differs from a fresh one at vertex index " << v << endl;
+                return;
+            }
+        }
+    }
+    catch (std::exception& e) {
+        cerr << "Error testing search context reuse: " << e.what() << endl;
+    }
+}
+
+void test_concurrent_shortestPath()
+{
+    try{
+        const Graph<int, string> g = createGraphFromFile("denison.txt");
+        const CompactGraph<int, string> c = g.freeze();
+        int pairs[][2] = {{73712, 635949}, {91442, 70838}, {35429, 615}, {635949, 73712}};
+        string expected[4];
+        string results[4];
+        string compactResults[4];
+        for (int i = 0; i < 4; i++) {
+            SearchContext ctx;
+            expected[i] = g.shortestPath(pairs[i][0], pairs[i][1], true, ctx);
+        }
+        vector<thread> threads;
+        for (int i = 0; i < 4; i++) {
+            threads.emplace_back([&, i]() {
+                SearchContext ctx;
+                results[i] = g.shortestPath(pairs[i][0], pairs[i][1], true, ctx);
+                compactResults[i] = c.shortestPath(pairs[i][0], pairs[i][1], true);
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        for (int i = 0; i < 4; i++) {
+            if (results[i] != expected[i] || compactResults[i] != expected[i]) {
+                cout << "Concurrent shortest path from " << pairs[i][0] << " to " << pairs[i][1] << " is incorrect. Expected: `" << expected[i] << "` but got: `" << results[i] << "` and `" << compactResults[i] << "`" << endl;
+            }
+        }
+    }
+    catch (std::exception& e) {
+        cerr << "Error testing concurrent shortest path: " << e.what() << endl;
+    }
+}
+
+void test_indexedHeap()
+{
+    IndexedHeap<double> heap;
+    heap.resize(100);
+    for (uint32_t v = 0; v < 100; v++) {
+        heap.push(v, (v * 37) % 101);
+    }
+    // decrease-key every third vertex, and try to raise one (ignored)
+    for (uint32_t v = 0; v < 100; v += 3) {
+        heap.push(v, -1.0 * v);
+    }
+    heap.push(1, 1000);
+    double last = -1e9;
+    uint32_t popped = 0;
+    while (!heap.empty()) {
+        double priority = heap.topPriority();
+        uint32_t v = heap.pop();
+        double expected = v % 3 == 0 ? -1.0 * v : (v * 37) % 101;
+        if (priority != expected || priority < last) {
+            cout << "IndexedHeap popped vertex " << v << " with priority " << priority << " out of order" << endl;
+            return;
+        }
+        last = priority;
+        popped++;
+    }
+    if (popped != 100 || heap.contains(5)) {
+        cout << "IndexedHeap popped " << popped << " vertices, expected 100" << endl;
+    }
+}
+
+void test_dijkstra_allDistances()
+{
+    try{
+        Graph<int, string> g = createGraphFromFile("denison.txt");
+        uint32_t n = g.numVertices();
+        uint32_t s = g.indexOf(73712);
+
+        // reference: O(V^2) dijkstra straight from getWeight
+        vector<double> dist(n, SearchContext::INF);
+        vector<bool> done(n, false);
+        dist[s] = 0;
+        for (uint32_t round = 0; round < n; round++) {
+            uint32_t u = NO_VERTEX;
+            for (uint32_t v = 0; v < n; v++) {
+                if (!done[v] && dist[v] != SearchContext::INF && (u == NO_VERTEX || dist[v] < dist[u]))
+                    u = v;
+            }
+            if (u == NO_VERTEX)
+                break;
+            done[u] = true;
+            for (auto e = g.edgesBegin(u); e != g.edgesEnd(u); ++e) {
+                uint32_t v = g.edgeTarget(e);
+                dist[v] = min(dist[v], dist[u] + g.edgeWeight(e));
+            }
+        }
+
+        SearchContext ctx;
+        g.dijkstra(73712, ctx);
+        for (uint32_t v = 0; v < n; v++) {
+            if (ctx.getDist(v) != dist[v]) {
+                cout << "Dijkstra distance to vertex index " << v << " is incorrect. Expected: " << dist[v] << " but got: " << ctx.getDist(v) << endl;
+                return;
+            }
+            uint32_t u = ctx.getPre(v);
+            if (u != NO_VERTEX && dist[u] + g.getWeight(g.keyAt(u), g.keyAt(v)) != dist[v]) {
+                cout << "Dijkstra predecessor of vertex index " << v << " is not on a shortest path" << endl;
+                return;
+            }
+        }
+    }
+    catch (std::exception& e) {
+        cerr << "Error testing dijkstra: " << e.what() << endl;
+    }
+}
+
+void test_astar()
+{
+    try{
+        Graph<int, string> g = createGraphFromFile("denison.txt");
+        CompactGraph<int, string> c = g.freeze();
+        int pairs[][2] = {{73712, 635949}, {91442, 70838}, {35429, 615}, {635949, 73712}, {70838, 91442}};
+        for (auto& pair : pairs) {
+            SearchContext dijkstraCtx;
+            SearchContext astarCtx;
+            string expected = g.shortestPath(pair[0], pair[1], true, dijkstraCtx);
+            string path = g.astar(pair[0], pair[1], astarCtx);
+            string compactPath = c.astar(pair[0], pair[1]);
+            if (path != expected || compactPath != expected) {
+                cout << "A* path from " << pair[0] << " to " << pair[1] << " is incorrect. Expected: `" << expected << "` but got: `" << path << "` and `" << compactPath << "`" << endl;
+            }
+            uint32_t touchedDijkstra = 0;
+            uint32_t touchedAstar = 0;
+            for (uint32_t v = 0; v < g.numVertices(); v++) {
+                touchedDijkstra += dijkstraCtx.isSettled(v);
+                touchedAstar += astarCtx.isSettled(v);
+            }
+            if (touchedAstar > touchedDijkstra) {
+                cout << "A* from " << pair[0] << " to " << pair[1] << " settled " << touchedAstar << " vertices, dijkstra only " << touchedDijkstra << endl;
+            }
+        }
+    }
+    catch (std::exception& e) {
+        cerr << "Error testing A*: " << e.what() << endl;
+    }
+}
+
+void test_bidirectional_shortestPath()
+{
+    try{
+        Graph<int, string> g = createGraphFromFile("denison.txt");
+        CompactGraph<int, string> c = g.freeze();
+        int pairs[][2] = {{73712, 635949}, {91442, 70838}, {35429, 615}, {635949, 73712}, {615, 615}};
+        for (auto& pair : pairs) {
+            for (bool weighted : {false, true}) {
+                string expected = g.shortestPath(pair[0], pair[1], weighted);
+                string path = g.shortestPathBidirectional(pair[0], pair[1], weighted);
+                string compactPath = c.shortestPathBidirectional(pair[0], pair[1], weighted);
+                // fewest-edge paths are rarely unique; compare total and hop count
+                if (!weighted) {
+                    auto summary = [](const string& p) { return p.substr(0, p.find('\n')) + "/" + to_string(count(p.begin(), p.end(), '\n')); };
+                    expected = summary(expected);
+                    path = summary(path);
+                    compactPath = summary(compactPath);
+                }
+                if (path != expected || compactPath != expected) {
+                    cout << "Bidirectional " << (weighted ? "weighted " : "") << "path from " << pair[0] << " to " << pair[1] << " is incorrect. Expected: `" << expected << "` but got: `" << path << "` and `" << compactPath << "`" << endl;
+                }
+            }
+        }
+
+        // the forward context keeps the colors its search gave it
+        SearchContext fwd, bwd;
+        g.shortestPathBidirectional(73712, 635949, false, fwd, bwd);
+        for (uint32_t v = 0; v < g.numVertices(); v++) {
+            char color = fwd.getColor(v);
+            if (color != 'w' && color != 'g' && color != 'b') {
+                cout << "Bidirectional search left color " << color << " in the forward context" << endl;
+                break;
+            }
+        }
+    }
+    catch (std::exception& e) {
+        cerr << "Error testing bidirectional shortestPath: " << e.what() << endl;
+    }
+}
+
+void test_contractionHierarchy()
+{
+    try{
+        Graph<int, string> g = createGraphFromFile("denison.txt");
+        ContractionHierarchy<int, string> ch(g);
+        int pairs[][2] = {{73712, 635949}, {91442, 70838}, {35429, 615}, {635949, 73712}, {70838, 91442}, {615, 615}};
+        for (auto& pair : pairs) {
+            string expected = g.shortestPath(pair[0], pair[1], true);
+            string path = ch.shortestPath(pair[0], pair[1]);
+            if (path != expected) {
+                cout << "Contraction hierarchy path from " << pair[0] << " to " << pair[1] << " is incorrect. Expected: `" << expected << "` but got: `" << path << "`" << endl;
+            }
+        }
+
+        // distances from one source to every vertex
+        SearchContext ctx;
+        g.dijkstra(73712, ctx);
+        for (uint32_t v = 0; v < g.numVertices(); v++) {
+            double expected = ctx.getDist(v);
+            double dist = ch.distance(73712, g.keyAt(v));
+            if (abs(dist - expected) > 1e-9 * max(1.0, expected) && !(dist == expected)) {
+                cout << "Contraction hierarchy distance from 73712 to " << g.keyAt(v) << " is incorrect. Expected: " << expected << " but got: " << dist << endl;
+            }
+        }
+    }
+    catch (std::exception& e) {
+        cerr << "Error testing contraction hierarchy: " << e.what() << endl;
+    }
+}
+
+void test_threadPool()
+{
+    try{
+        ThreadPool pool(4);
+        vector<int> hits(100000, 0);
+        pool.parallelFor(hits.size(), [&](size_t begin, size_t end, unsigned) {
+            for (size_t i = begin; i < end; i++)
+                hits[i]++;
+        });
+        if (count(hits.begin(), hits.end(), 1) != (long)hits.size()) {
+            cout << "parallelFor did not run every iteration once" << endl;
+        }
+
+        // the first exception comes back once every worker is done with the body
+        atomic<int> inside(0);
+        bool threw = false;
+        try {
+            pool.parallelFor(hits.size(), [&](size_t begin, size_t, unsigned) {
+                inside++;
+                this_thread::sleep_for(chrono::microseconds(50));
+                inside--;
+                if (begin >= hits.size() / 2)
+                    throw runtime_error("chunk failed");
+            }, 100);
+        } catch (const runtime_error& e) {
+            threw = string(e.what()) == "chunk failed";
+        }
+        if (!threw || inside != 0) {
+            cout << "parallelFor did not rethrow after its workers finished" << endl;
+        }
+
+        // a loop inside a loop of the same pool would wait on itself
+        threw = false;
+        try {
+            pool.parallelFor(hits.size(), [&](size_t, size_t, unsigned) {
+                pool.parallelFor(10, [](size_t, size_t, unsigned) { });
+            });
+        } catch (const logic_error&) {
+            threw = true;
+        }
+        if (!threw) {
+            cout << "Nested parallelFor on the same pool did not throw" << endl;
+        }
+
+        // the pool still works afterwards
+        fill(hits.begin(), hits.end(), 0);
+        pool.parallelFor(hits.size(), [&](size_t begin, size_t end, unsigned) {
+            for (size_t i = begin; i < end; i++)
+                hits[i]++;
+        });
+        if (count(hits.begin(), hits.end(), 1) != (long)hits.size()) {
+            cout << "parallelFor is incorrect after an exception" << endl;
+        }
+    }
+    catch (std::exception& e) {
+        cerr << "Error testing thread pool: " << e.what() << endl;
+    }
+}
+
+void test_parallel_BFS()
+{
+    try{
+        Graph<int, string> g = createGraphFromFile("denison.txt");
+        CompactGraph<int, string> c = g.freeze();
+        ThreadPool pool(4);
+        int sources[] = {73712, 91442, 35429, 615};
+        for (int source : sources) {
+            SearchContext expected;
+            SearchContext result;
+            c.BFS(source, expected);
+            c.BFS(source, result, pool);
+            for (uint32_t v = 0; v < c.numVertices(); v++) {
+                if (result.getDist(v) != expected.getDist(v) || result.getPre(v) != expected.getPre(v)) {
+                    cout << "Parallel BFS from " << source << " is incorrect at vertex " << c.keyAt(v) << ". Expected: " << expected.getDist(v) << " via " << expected.getPre(v) << " but got: " << result.getDist(v) << " via " << result.getPre(v) << endl;
+                    break;
+                }
+            }
+        }
+    }
+    catch (std::exception& e) {
+        cerr << "Error testing parallel BFS: " << e.what() << endl;
+    }
+}
+
+void test_deltaStepping()
+{
+    try{
+        Graph<int, string> g = createGraphFromFile("denison.txt");
+        CompactGraph<int, string> c = g.freeze();
+        ThreadPool pool(4);
+        int sources[] = {73712, 91442, 35429, 615};
+        for (int source : sources) {
+            for (double delta : {0.0, 0.5, 5.0}) {
+                SearchContext expected;
+                SearchContext result;
+                SearchContext compactResult;
+                g.dijkstra(source, expected);
+                g.deltaStepping(source, result, pool, delta);
+                c.deltaStepping(source, compactResult, pool, delta);
+                for (uint32_t v = 0; v < g.numVertices(); v++) {
+                    if (result.getDist(v) != expected.getDist(v) || result.getPre(v) != expected.getPre(v)
+                        || compactResult.getDist(v) != expected.getDist(v) || compactResult.getPre(v) != expected.getPre(v)) {
+                        cout << "Delta-stepping from " << source << " with delta " << delta << " is incorrect at vertex " << g.keyAt(v) << endl;
+                        break;
+                    }
+                }
+            }
+        }
+        g.deltaStepping(73712, 0, 2);
+        string path = g.shortestPathRecursive(73712, 635949, 0, true);
+        if (path != g.shortestPath(73712, 635949, true)) {
+            cout << "Path after deltaStepping is incorrect. Got: `" << path << "`" << endl;
+        }
+    }
+    catch (std::exception& e) {
+        cerr << "Error testing deltaStepping: " << e.what() << endl;
+    }
+}
+
+struct RecordingVisitor
+{
+    vector<tuple<char, uint32_t, int>> events;
+    int backEdges = 0;
+    void onDiscover ( uint32_t u, int time ) { events.push_back(make_tuple('d', u, time)); }
+    void onFinish   ( uint32_t u, int time ) { events.push_back(make_tuple('f', u, time)); }
+    void onEdge     ( uint32_t, uint32_t, char color ) { backEdges += color == 'g'; }
+};
+
+void test_DFS_deepChain()
+{
+    try{
+        // one long path; a recursive DFS would need a frame per vertex
+        const int length = 200000;
+        Graph<int, string> g;
+        for (int i = 0; i < length; i++)
+            g.insertVertex(i, make_tuple(0.0, 0.0));
+        for (int i = 0; i + 1 < length; i++)
+            g.insertEdge(i, i + 1, 1, "chain");
+        g.insertEdge(length - 1, 0, 1, "back");
+
+        SearchContext ctx;
+        RecordingVisitor visitor;
+        g.DFS(ctx, visitor);
+        for (uint32_t u = 0; u < length; u++) {
+            if (ctx.getDTime(u) != int(u) + 1 || ctx.getFTime(u) != 2 * length - int(u) || ctx.getPre(u) != (u == 0 ? NO_VERTEX : u - 1)) {
+                cout << "DFS on a deep chain is incorrect at vertex " << u << endl;
+                break;
+            }
+        }
+        if (visitor.events.size() != 2 * size_t(length) || visitor.events[length - 1] != make_tuple('d', uint32_t(length - 1), length)
+            || visitor.events[length] != make_tuple('f', uint32_t(length - 1), length + 1) || visitor.backEdges != 1) {
+            cout << "DFS visitor events are incorrect" << endl;
+        }
+    }
+    catch (std::exception& e) {
+        cerr << "Error testing DFS on a deep chain: " << e.what() << endl;
+    }
+}
+
+void test_topologicalSort_kahn()
+{
+    try{
+        Graph<int, string> g;
+        for (int key : {5, 3, 9, 1, 7, 4})
+            g.insertVertex(key, make_tuple(0.0, 0.0));
+        g.insertEdge(5, 9, 1, "");
+        g.insertEdge(3, 9, 1, "");
+        g.insertEdge(1, 3, 1, "");
+        g.insertEdge(9, 7, 1, "");
+        g.insertEdge(4, 7, 1, "");
+        CompactGraph<int, string> c = g.freeze();
+        ThreadPool pool(3);
+
+        string result = g.topologicalSort();
+        if (result != "5->1->4->3->9->7" || c.topologicalSort() != result) {
+            cout << "Kahn topological sort is incorrect. Expected: 5->1->4->3->9->7 but got: " << result << " and " << c.topologicalSort() << endl;
+        }
+        vector<int> order = g.topologicalOrder();
+        if (order != vector<int>({5, 1, 4, 3, 9, 7})) {
+            cout << "Topological order is incorrect" << endl;
+        }
+        vector<vector<int>> expected = {{5, 1, 4}, {3}, {9}, {7}};
+        if (g.topologicalLevels() != expected || g.topologicalLevels(pool) != expected
+            || c.topologicalLevels() != expected || c.topologicalLevels(pool) != expected) {
+            cout << "Topological wavefronts are incorrect" << endl;
+        }
+
+        g.insertEdge(7, 3, 1, "");
+        try {
+            g.topologicalSort();
+            cout << "Topological sort of a cyclic graph did not throw" << endl;
+        }
+        catch (invalid_argument& e) {
+            if (string(e.what()) != "Error in topologicalSort: Graph has a cycle 9->7->3->9") {
+                cout << "Topological sort cycle witness is incorrect: " << e.what() << endl;
+            }
+        }
+    }
+    catch (std::exception& e) {
+        cerr << "Error testing Kahn topological sort: " << e.what() << endl;
+    }
+}
+
+void test_loadGraph()
+{
+    try{
+        Graph<int, string> expected = createGraphFromFile("denison.txt");
+        Graph<int, string> g = loadGraph<int, string>("denison.txt");
+        bool same = g.numVertices() == expected.numVertices();
+        for (uint32_t u = 0; same && u < g.numVertices(); u++) {
+            same = g.keyAt(u) == expected.keyAt(u) && g.vertexData(u) == expected.vertexData(u);
+            auto e = expected.edgesBegin(u);
+            for (auto f = g.edgesBegin(u); same && f != g.edgesEnd(u); ++f, ++e) {
+                // the test reader parses weights as float
+                same = e != expected.edgesEnd(u) && g.edgeTarget(f) == expected.edgeTarget(e)
+                    && float(g.edgeWeight(f)) == float(expected.edgeWeight(e)) && g.edgeLabel(f) == expected.edgeLabel(e);
+            }
+            same = same && e == expected.edgesEnd(u);
+            auto r = expected.inEdgesBegin(u);
+            for (auto f = g.inEdgesBegin(u); same && f != g.inEdgesEnd(u); ++f, ++r)
+                same = r != expected.inEdgesEnd(u) && g.inEdgeSource(f) == expected.inEdgeSource(r);
+        }
+        if (!same) {
+            cout << "loadGraph of denison.txt does not match createGraphFromFile" << endl;
+        }
+
+        // blank handling, CRLF line ends and a repeated edge
+        {
+            ofstream out("loader_test.txt", ios::binary);
+            out << "3 4\r\n7 1.5 -2\r\n\t8 2.5 -3   \r\n9 0 0\r\n7 8 1.25   Main  Street \t\r\n8 9 2\r\n7 8 0.75 Elm\r\n9 7 3";
+        }
+        Graph<int, string> small = loadGraph<int, string>("loader_test.txt");
+        remove("loader_test.txt");
+        uint32_t seven = small.indexOf(7);
+        if (small.numVertices() != 3 || get<0>(small.vertexData(small.indexOf(8))) != 2.5 || small.getWeight(7, 8) != 0.75
+            || small.edgeLabel(small.edgesBegin(seven)) != "Elm" || next(small.edgesBegin(seven)) != small.edgesEnd(seven)
+            || small.getWeight(9, 7) != 3 || small.edgeLabel(small.edgesBegin(small.indexOf(8))) != "") {
+            cout << "loadGraph of a file with blanks and a repeated edge is incorrect: " << small.toString() << endl;
+        }
+
+        try {
+            ofstream("loader_test.txt") << "2 1\n1 0 0\n2 0 0\n1 x 5\n";
+            loadGraph<int, string>("loader_test.txt");
+            cout << "loadGraph of a malformed file did not throw" << endl;
+        }
+        catch (invalid_argument& e) {
+            if (string(e.what()) != "Error in loadGraph: expected an integer on line 4") {
+                cout << "loadGraph error is incorrect: " << e.what() << endl;
+            }
+        }
+
+        // a weight running into its label is an error, not a label
+        try {
+            ofstream("loader_test.txt") << "2 1\n1 0 0\n2 0 0\n1 2 12.5abc\n";
+            loadGraph<int, string>("loader_test.txt");
+            cout << "loadGraph of a weight followed by text did not throw" << endl;
+        }
+        catch (invalid_argument& e) {
+            if (string(e.what()) != "Error in loadGraph: expected a number on line 4") {
+                cout << "loadGraph error is incorrect: " << e.what() << endl;
+            }
+        }
+        remove("loader_test.txt");
+    }
+    catch (std::exception& e) {
+        cerr << "Error testing loadGraph: " << e.what() << endl;
+    }
+}
+
+void test_bulkConstructor()
+{
+    try{
+        // enough vertices that the build really runs on several threads,
+        // with many repeated edges and a few high-degree vertices
+        vector<int> keys;
+        vector<tuple<double, double>> data;
+        for (int i = 0; i < 3000; i++) {
+            keys.push_back(i * 7);
+            data.push_back(make_tuple(-82.5 + i % 50 * 0.001, 40.0 + i / 50 * 0.001));
+        }
+        vector<tuple<int, int, double, string>> edges;
+        uint32_t seed = 271;
+        for (int i = 0; i < 40000; i++) {
+            seed = seed * 1103515245 + 12345;
+            int from = (seed >> 8) % 3000;
+            if (i % 5 == 0)
+                from = from % 3;
+            seed = seed * 1103515245 + 12345;
+            int to = (seed >> 8) % (i % 2 ? 40 : 3000);
+            edges.push_back(make_tuple(from * 7, to * 7, 1 + i % 13, "road " + to_string(i % 17)));
+        }
+
+        Graph<int, string> expected;
+        for (size_t i = 0; i < keys.size(); i++)
+            expected.insertVertex(keys[i], data[i]);
+        for (auto& edge : edges)
+            expected.insertEdge(get<0>(edge), get<1>(edge), get<2>(edge), get<3>(edge));
+        Graph<int, string> g(keys, data, edges, 4);
+
+        bool same = g.numVertices() == expected.numVertices() && g.heuristicScale() == expected.heuristicScale();
+        for (uint32_t u = 0; same && u < g.numVertices(); u++) {
+            auto e = expected.edgesBegin(u);
+            for (auto f = g.edgesBegin(u); same && f != g.edgesEnd(u); ++f, ++e) {
+                same = e != expected.edgesEnd(u) && g.edgeTarget(f) == expected.edgeTarget(e)
+                    && g.edgeWeight(f) == expected.edgeWeight(e) && g.edgeLabel(f) == expected.edgeLabel(e);
+            }
+            same = same && e == expected.edgesEnd(u) && g.inEdgesEnd(u) - g.inEdgesBegin(u) == expected.inEdgesEnd(u) - expected.inEdgesBegin(u);
+            for (auto f = g.inEdgesBegin(u), r = expected.inEdgesBegin(u); same && f != g.inEdgesEnd(u); ++f, ++r) {
+                same = g.inEdgeSource(f) == expected.inEdgeSource(r) && g.inEdgeWeight(f) == expected.inEdgeWeight(r);
+            }
+        }
+        if (!same) {
+            cout << "Bulk constructor does not match inserting the edges one at a time" << endl;
+        }
+
+        try {
+            Graph<int, string> bad(keys, data, {make_tuple(0, 1, 1.0, string(""))}, 2);
+            cout << "Bulk constructor with a missing vertex did not throw" << endl;
+        }
+        catch (invalid_argument& e) {
+            if (string(e.what()) != "Error in insertEdges: One or both vertices not found.") {
+                cout << "Bulk constructor error is incorrect: " << e.what() << endl;
+            }
+        }
+    }
+    catch (std::exception& e) {
+        cerr << "Error testing bulk constructor: " << e.what() << endl;
+    }
+}
+
+void test_labelPool()
+{
+    try{
+        LabelPool pool;
+        uint32_t broadway = pool.intern("East Broadway");
+        if (pool.intern("") != 0 || pool.intern("East Broadway") != broadway || pool.text(broadway) != "East Broadway"
+            || pool.intern("North Pearl Street") == broadway || pool.size() != 3) {
+            cout << "LabelPool ids are incorrect" << endl;
+        }
+        // a copy looks labels up in its own texts once the original is gone
+        LabelPool* original = new LabelPool();
+        original->intern("East Broadway");
+        original->intern("North Pearl Street");
+        LabelPool copy = *original;
+        LabelPool assigned;
+        assigned = *original;
+        delete original;
+        if (copy.intern("East Broadway") != broadway || assigned.intern("North Pearl Street") != 2 || copy.size() != 3) {
+            cout << "LabelPool copy is incorrect" << endl;
+        }
+
+        Graph<int, string> g;
+        for (int key : {1, 2, 3})
+            g.insertVertex(key, make_tuple(0.0, 0.0));
+        g.insertEdge(1, 2, 1, "East Broadway");
+        g.insertEdge(2, 3, 1, "East Broadway");
+        g.insertEdge(3, 1, 1, "Elm");
+        g.insertEdge(3, 1, 2, "Main");
+        const string& first = g.edgeLabel(g.edgesBegin(g.indexOf(1)));
+        const string& second = g.edgeLabel(g.edgesBegin(g.indexOf(2)));
+        // equal labels are stored once
+        if (&first != &second || first != "East Broadway" || g.edgeLabel(g.edgesBegin(g.indexOf(3))) != "Main") {
+            cout << "Edge labels are incorrect" << endl;
+        }
+    }
+    catch (std::exception& e) {
+        cerr << "Error testing labelPool: " << e.what() << endl;
+    }
+}
+
+void test_findPath()
+{
+    try{
+        Graph<int, string> g = createGraphFromFile("denison.txt");
+        CompactGraph<int, string> c = g.freeze();
+        ContractionHierarchy<int, string> ch(c);
+        Path path = g.findPath(73712, 635949, true);
+        bool chained = path.found() && path.vertices.front() == g.indexOf(73712) && path.vertices.back() == g.indexOf(635949)
+            && path.edges.size() + 1 == path.vertices.size() && path.distances.size() == path.vertices.size();
+        for (size_t i = 0; chained && i < path.edges.size(); i++) {
+            auto e = g.edgesBegin(path.vertices[i]) + path.edges[i];
+            chained = g.edgeTarget(e) == path.vertices[i + 1] && path.distances[i + 1] == path.distances[i] + g.edgeWeight(e);
+        }
+        if (!chained) {
+            cout << "findPath from 73712 to 635949 is not a chain of edges" << endl;
+        }
+        if (formatPathText(g, path) != g.shortestPath(73712, 635949, true)) {
+            cout << "formatPathText does not match shortestPath" << endl;
+        }
+        Path compact = c.findPath(73712, 635949, true);
+        Path hierarchy = ch.findPath(73712, 635949);
+        if (compact.vertices != path.vertices || compact.edges != path.edges || hierarchy.vertices != path.vertices
+            || hierarchy.total() != path.total()) {
+            cout << "findPath of CompactGraph or ContractionHierarchy does not match Graph" << endl;
+        }
+        if (g.findPath(73712, 635949).total() > path.edges.size()) {
+            cout << "Unweighted findPath has more hops than a weighted path" << endl;
+        }
+
+        Graph<int, string> small;
+        small.insertVertex(1, make_tuple(-82.5, 40.25));
+        small.insertVertex(2, make_tuple(-82.75, 40));
+        small.insertVertex(3, make_tuple(0.0, 0.0));
+        small.insertEdge(1, 2, 2.5, "Elm \"Street\"");
+        Path hop = small.findPath(1, 2, true);
+        string json = formatPathJSON(small, hop);
+        string expected = "{\"found\": true, \"distance\": 2.5, \"vertices\": [{\"key\": 1, \"x\": -82.5, \"y\": 40.25, \"distance\": 0}, "
+            "{\"key\": 2, \"x\": -82.75, \"y\": 40, \"distance\": 2.5, \"edge\": 0, \"label\": \"Elm \\\"Street\\\"\"}]}";
+        if (json != expected) {
+            cout << "formatPathJSON is incorrect. Expected: `" << expected << "` but got: `" << json << "`" << endl;
+        }
+        string geo = formatPathGeoJSON(small, hop);
+        expected = "{\"type\": \"Feature\", \"geometry\": {\"type\": \"LineString\", \"coordinates\": [[-82.5, 40.25], [-82.75, 40]]}, "
+            "\"properties\": {\"distance\": 2.5, \"labels\": [\"Elm \\\"Street\\\"\"]}}";
+        if (geo != expected) {
+            cout << "formatPathGeoJSON is incorrect. Expected: `" << expected << "` but got: `" << geo << "`" << endl;
+        }
+        Path none = small.findPath(2, 3);
+        if (none.found() || formatPathText(small, none) != "" || formatPathJSON(small, none) != "{\"found\": false, \"distance\": null, \"vertices\": []}"
+            || formatPathGeoJSON(small, none) != "{\"type\": \"Feature\", \"geometry\": null, \"properties\": {\"distance\": null, \"labels\": []}}") {
+            cout << "Formatting a missing path is incorrect" << endl;
+        }
+
+        try {
+            small.findPath(1, 4);
+            cout << "findPath with a missing vertex did not throw" << endl;
+        }
+        catch (invalid_argument& e) {
+            if (string(e.what()) != "Error in findPath: One or both vertices not found.") {
+                cout << "findPath error is incorrect: " << e.what() << endl;
+            }
+        }
+    }
+    catch (std::exception& e) {
+        cerr << "Error testing findPath: " << e.what() << endl;
+    }
+}
+
+void test_distanceTable()
+{
+    try{
+        Graph<int, string> g = createGraphFromFile("denison.txt");
+        CompactGraph<int, string> c = g.freeze();
+        ContractionHierarchy<int, string> ch(c);
+        vector<int> sources = {73712, 91442, 35429, 635949, 615, 70838};
+        vector<int> targets = {635949, 70838, 615, 73712, 635949};
+        Matrix<double> table = g.distanceTable(sources, targets, 3);
+        Matrix<double> compact = c.distanceTable(sources, targets, 3);
+        Matrix<double> hierarchy = ch.distanceTable(sources, targets, 3);
+        if (table.rows() != sources.size() || table.cols() != targets.size()) {
+            cout << "distanceTable has " << table.rows() << " x " << table.cols() << " entries" << endl;
+            return;
+        }
+        SearchContext ctx;
+        for (uint32_t i = 0; i < sources.size(); i++) {
+            g.dijkstra(sources[i], ctx);
+            for (uint32_t j = 0; j < targets.size(); j++) {
+                double expected = ctx.getDist(g.indexOf(targets[j]));
+                double got = hierarchy(i, j);
+                if (table(i, j) != expected || compact(i, j) != expected
+                    || (abs(got - expected) > 1e-9 * max(1.0, expected) && !(got == expected))) {
+                    cout << "distanceTable from " << sources[i] << " to " << targets[j] << " is incorrect. Expected: " << expected
+                         << " but got: " << table(i, j) << ", " << compact(i, j) << ", " << got << endl;
+                }
+            }
+        }
+
+        try {
+            g.distanceTable({73712}, {12345678});
+            cout << "distanceTable with a missing vertex did not throw" << endl;
+        }
+        catch (invalid_argument& e) {
+            if (string(e.what()) != "Error in distanceTable: Vertex not found.") {
+                cout << "distanceTable error is incorrect: " << e.what() << endl;
+            }
+        }
+    }
+    catch (std::exception& e) {
+        cerr << "Error testing distanceTable: " << e.what() << endl;
+    }
+}
+
+void test_allPairsShortestPaths()
+{
+    try{
+        // 150 vertices, so the last tile row and column are partial
+        Graph<int, string> g;
+        for (int i = 0; i < 150; i++)
+            g.insertVertex(i * 7 % 150, make_tuple(0.0, 0.0));
+        uint32_t seed = 7;
+        for (int i = 0; i < 600; i++) {
+            seed = seed * 1103515245 + 12345;
+            int from = (seed >> 8) % 150;
+            seed = seed * 1103515245 + 12345;
+            int to = (seed >> 8) % 140;   // vertices 140..149 are never reached
+            g.insertEdge(from, to, 1 + (seed >> 20) % 50, "");
+        }
+
+        Matrix<double> dist = g.allPairsShortestPaths(3);
+        bool same = dist.rows() == 150 && dist.cols() == 150;
+        SearchContext ctx;
+        for (int s = 0; same && s < 150; s++) {
+            g.dijkstra(s, ctx);
+            for (int t = 0; same && t < 150; t++)
+                same = dist(s, t) == ctx.getDist(g.indexOf(t));
+        }
+        if (!same) {
+            cout << "allPairsShortestPaths does not match dijkstra" << endl;
+        }
+
+        // the int version keeps INT_MAX for no path, and the diagonal
+        // of asAdjMatrix (INT_MAX) becomes the shortest cycle
+        Matrix<int> hops = g.adjacencyMatrix();
+        Matrix<int> expected = hops;
+        for (int k = 0; k < 150; k++)
+            for (int i = 0; i < 150; i++)
+                for (int j = 0; j < 150; j++)
+                    if (expected(i, k) != INT_MAX && expected(k, j) != INT_MAX)
+                        expected(i, j) = min<long long>(expected(i, j), (long long)expected(i, k) + expected(k, j));
+        ThreadPool pool(3);
+        floydWarshall(hops, pool);
+        if (!equal(hops.data(), hops.data() + 150 * 150, expected.data()) || hops(0, 145) != INT_MAX) {
+            cout << "floydWarshall on an int matrix is incorrect" << endl;
+        }
+
+        try {
+            Matrix<double> wide(2, 3);
+            floydWarshall(wide, pool);
+            cout << "floydWarshall of a non-square matrix did not throw" << endl;
+        }
+        catch (invalid_argument& e) {
+            if (string(e.what()) != "Error in floydWarshall: Matrix is not square.") {
+                cout << "floydWarshall error is incorrect: " << e.what() << endl;
+            }
+        }
+    }
+    catch (std::exception& e) {
+        cerr << "Error testing allPairsShortestPaths: " << e.what() << endl;
+    }
+}
+
+void test_matrixExports()
+{
+    try{
+        // keys that are not 0..numV-1, inserted out of order
+        Graph<int, string> g;
+        for (int key : {100, -5, 42, 7, 9})
+            g.insertVertex(key, make_tuple(0.0, 0.0));
+        g.insertEdge(100, -5, 2.5, "");
+        g.insertEdge(100, 7, 1, "");
+        g.insertEdge(-5, 42, 3, "");
+        g.insertEdge(42, -5, 4, "");
+        g.insertEdge(9, 100, 6, "");
+
+        // rows and columns are -5, 7, 9, 42, 100
+        if (g.matrixKeys() != vector<int>({-5, 7, 9, 42, 100})) {
+            cout << "matrixKeys is incorrect" << endl;
+        }
+        CsrMatrix csr = g.sparseMatrix();
+        if (csr.numRows != 5 || csr.offsets != vector<uint32_t>({0, 1, 1, 2, 3, 5}) || csr.columns != vector<uint32_t>({3, 4, 0, 0, 1})
+            || csr.values != vector<double>({3, 6, 4, 2.5, 1})) {
+            cout << "sparseMatrix is incorrect" << endl;
+        }
+        CooMatrix coo = g.coordinateMatrix();
+        if (coo.rowIndex != vector<uint32_t>({0, 2, 3, 4, 4}) || coo.colIndex != csr.columns || coo.values != csr.values) {
+            cout << "coordinateMatrix is incorrect" << endl;
+        }
+
+        BitMatrix adjacent = g.adjacencyBits();
+        BitMatrix reach = g.reachabilityBits(2);
+        Matrix<int> dense = g.adjacencyMatrix();
+        bool same = adjacent.count() == 5 && reach.rows() == 5 && reach.wordsPerRow() == 1;
+        for (uint32_t r = 0; r < 5; r++) {
+            for (uint32_t c = 0; c < 5; c++)
+                same = same && adjacent.get(r, c) == (dense(r, c) != INT_MAX);
+        }
+        // 9 reaches everything, 7 only itself, -5 and 42 each other
+        same = same && reach.row(2)[0] == 0x1f && reach.row(1)[0] == 0x2 && reach.row(0)[0] == 0x9 && reach.row(3)[0] == 0x9;
+        if (!same) {
+            cout << "adjacencyBits or reachabilityBits is incorrect" << endl;
+        }
+
+        int** old = g.asAdjMatrix();
+        for (int r = 0; r < 5; r++) {
+            if (!equal(old[r], old[r] + 5, dense.row(r))) {
+                cout << "adjacencyMatrix row " << r << " does not match asAdjMatrix" << endl;
+            }
+            delete[] old[r];
+        }
+        delete[] old;
+
+        // weights an int cannot hold, such as an edge cut with an infinite weight
+        Graph<int, string> h;
+        for (int key : {1, 2, 3, 4})
+            h.insertVertex(key, make_tuple(0.0, 0.0));
+        h.insertEdge(1, 2, SearchContext::INF, "cut");
+        h.insertEdge(1, 3, 3e9, "");
+        h.insertEdge(2, 3, numeric_limits<double>::quiet_NaN(), "");
+        h.insertEdge(3, 4, 5.7, "");
+        h.insertEdge(4, 1, -3e9, "");
+        h.insertEdge(4, 2, -SearchContext::INF, "");
+        Matrix<int> clamped = h.adjacencyMatrix();
+        if (clamped(0, 1) != INT_MAX || clamped(0, 2) != INT_MAX || clamped(1, 2) != INT_MAX || clamped(2, 3) != 5
+            || clamped(3, 0) != INT_MIN || clamped(3, 1) != INT_MAX) {
+            cout << "adjacencyMatrix of out-of-range weights is incorrect" << endl;
+        }
+        int** clampedOld = h.asAdjMatrix();
+        for (int r = 0; r < 4; r++) {
+            if (!equal(clampedOld[r], clampedOld[r] + 4, clamped.row(r))) {
+                cout << "asAdjMatrix of out-of-range weights is incorrect" << endl;
+            }
+            delete[] clampedOld[r];
+        }
+        delete[] clampedOld;
+        h.insertEdge(3, 1, INT_MAX, "");
+        CompactGraph<int, string> frozen = h.freeze();
+        if (!h.isEdge(3, 1) || !frozen.isEdge(3, 1) || frozen.isEdge(3, 2) || !frozen.isEdge(1, 2) || frozen.getWeight(1, 2) != SearchContext::INF) {
+            cout << "Frozen graph isEdge or getWeight is incorrect for INT_MAX or infinite weights" << endl;
+        }
+    }
+    catch (std::exception& e) {
+        cerr << "Error testing matrix exports: " << e.what() << endl;
+    }
+}
+
+void test_saveOpen()
+{
+    try{
+        Graph<int, string> g = createGraphFromFile("denison.txt");
+        CompactGraph<int, string> c = g.freeze();
+        c.save("binary_test.graph");
+        CompactGraph<int, string> opened = CompactGraph<int, string>::open("binary_test.graph");
+        // a copy shares the mapping, so it stays readable after the original is gone
+        CompactGraph<int, string> copy = opened;
+        opened = CompactGraph<int, string>();
+        if (copy.numVertices() != c.numVertices() || copy.numEdges() != c.numEdges()) {
+            cout << "Opened graph has " << copy.numVertices() << " vertices and " << copy.numEdges() << " edges" << endl;
+        }
+        int pairs[][2] = {{73712, 635949}, {91442, 70838}, {35429, 615}, {635949, 73712}};
+        for (auto& pair : pairs) {
+            for (bool weighted : {false, true}) {
+                string expected = c.shortestPath(pair[0], pair[1], weighted);
+                string path = copy.shortestPath(pair[0], pair[1], weighted);
+                if (path != expected) {
+                    cout << "Opened graph shortest path from " << pair[0] << " to " << pair[1] << " is incorrect. Expected: `" << expected << "` but got: `" << path << "`" << endl;
+                }
+            }
+            if (copy.astar(pair[0], pair[1]) != c.astar(pair[0], pair[1])) {
+                cout << "Opened graph A* from " << pair[0] << " to " << pair[1] << " is incorrect" << endl;
+            }
+        }
+        if (copy.indexOf(12345678) != NO_VERTEX || copy.getWeight(91442, 91444) != c.getWeight(91442, 91444)) {
+            cout << "Opened graph key lookup is incorrect" << endl;
+        }
+
+        // a bad offset or target is refused by open, not found later by a search;
+        // the positions follow the layout described in compact_graph.h
+        ifstream saved("binary_test.graph", ios::binary);
+        string original((istreambuf_iterator<char>(saved)), istreambuf_iterator<char>());
+        saved.close();
+        uint32_t n, m, capacity;
+        memcpy(&n, &original[16], 4);
+        memcpy(&m, &original[20], 4);
+        memcpy(&capacity, &original[28], 4);
+        auto align = [](uint64_t at) { return (at + 15) / 16 * 16; };
+        uint64_t indexAt = align(64 + 4 * uint64_t(n));
+        uint64_t coordsAt = align(indexAt + 8 * uint64_t(capacity));
+        uint64_t offsetsAt = align(coordsAt + 16 * uint64_t(n));
+        uint64_t targetsAt = align(offsetsAt + 4 * (n + uint64_t(1)));
+        for (uint64_t at : {offsetsAt + 4 * 10, targetsAt + 4 * 5}) {
+            string bad = original;
+            uint32_t huge = 4000000000u;
+            memcpy(&bad[at], &huge, 4);
+            ofstream("binary_test.graph", ios::binary | ios::trunc) << bad;
+            try {
+                CompactGraph<int, string>::open("binary_test.graph");
+                cout << "open of a corrupt file did not throw" << endl;
+            }
+            catch (runtime_error& e) {
+                if (string(e.what()).find("is corrupt") == string::npos) {
+                    cout << "open error is incorrect: " << e.what() << endl;
+                }
+            }
+        }
+        remove("binary_test.graph");
+
+        CompactGraph<int, string>().save("binary_test.graph");
+        if (CompactGraph<int, string>::open("binary_test.graph").numVertices() != 0) {
+            cout << "Opened empty graph is not empty" << endl;
+        }
+        remove("binary_test.graph");
+
+        try {
+            ofstream("binary_test.graph") << "CSRGRAPH but not really";
+            CompactGraph<int, string>::open("binary_test.graph");
+            cout << "open of a truncated file did not throw" << endl;
+        }
+        catch (runtime_error& e) {
+            if (string(e.what()) != "Error in open: binary_test.graph is not a saved graph") {
+                cout << "open error is incorrect: " << e.what() << endl;
+            }
+        }
+        remove("binary_test.graph");
+    }
+    catch (std::exception& e) {
+        cerr << "Error testing save and open: " << e.what() << endl;
+    }
+}
+
+void test_spatialIndex()
+{
+    try{
+        Graph<int, string> g = createGraphFromFile("denison.txt");
+        CompactGraph<int, string> c = g.freeze();
+        // distance from a query point to every vertex, checked against a linear scan
+        auto scan = [&](double lon, double lat) {
+            vector<pair<double, int>> all;
+            for (uint32_t u = 0; u < g.numVertices(); u++)
+                all.push_back(make_pair(haversineDistance(make_tuple(lon, lat), g.vertexData(u)), g.keyAt(u)));
+            sort(all.begin(), all.end());
+            return all;
+        };
+        auto distance = [&](double lon, double lat, int key) {
+            return haversineDistance(make_tuple(lon, lat), g.vertexData(g.indexOf(key)));
+        };
+        mt19937 rng(7);
+        uniform_real_distribution<double> lonDist(-82.54, -82.49);
+        uniform_real_distribution<double> latDist(40.06, 40.09);
+        for (int q = 0; q < 200; q++) {
+            double lon = lonDist(rng);
+            double lat = latDist(rng);
+            vector<pair<double, int>> all = scan(lon, lat);
+            int nearest = g.nearestVertex(lon, lat);
+            if (fabs(distance(lon, lat, nearest) - all[0].first) > 1e-6 || c.nearestVertex(lon, lat) != nearest) {
+                cout << "nearestVertex of (" << lon << ", " << lat << ") is incorrect" << endl;
+            }
+            vector<int> five = g.nearestVertices(lon, lat, 5);
+            bool same = five.size() == 5;
+            for (size_t i = 0; same && i < five.size(); i++)
+                same = fabs(distance(lon, lat, five[i]) - all[i].first) < 1e-6;
+            if (!same) {
+                cout << "nearestVertices of (" << lon << ", " << lat << ") is incorrect" << endl;
+            }
+            vector<int> near = g.verticesWithin(lon, lat, 150);
+            size_t expected = 0;
+            while (expected < all.size() && all[expected].first <= 150)
+                expected++;
+            if (near.size() != expected || (expected > 0 && distance(lon, lat, near.back()) > 150)) {
+                cout << "verticesWithin of (" << lon << ", " << lat << ") has " << near.size() << " vertices, expected " << expected << endl;
+            }
+        }
+
+        vector<int> box = c.verticesInBox(-82.52, 40.07, -82.51, 40.075);
+        vector<int> boxExpected;
+        for (uint32_t u = 0; u < g.numVertices(); u++) {
+            double lon = get<0>(g.vertexData(u));
+            double lat = get<1>(g.vertexData(u));
+            if (lon >= -82.52 && lon <= -82.51 && lat >= 40.07 && lat <= 40.075)
+                boxExpected.push_back(g.keyAt(u));
+        }
+        if (box != boxExpected || box.empty()) {
+            cout << "verticesInBox is incorrect" << endl;
+        }
+
+        // a route between two coordinates starts and ends at the snapped vertices
+        tuple<double, double> from = g.vertexData(g.indexOf(73712));
+        tuple<double, double> to = g.vertexData(g.indexOf(635949));
+        get<0>(from) += 1e-6;
+        if (g.shortestPath(from, to, true) != g.shortestPath(73712, 635949, true)
+            || c.findPath(from, to).vertices != c.findPath(73712, 635949).vertices) {
+            cout << "shortestPath between coordinates is incorrect" << endl;
+        }
+
+        // points on both sides of the antimeridian
+        Graph<int, string> world;
+        world.insertVertex(1, make_tuple(179.9, 0.0));
+        world.insertVertex(2, make_tuple(-179.9, 0.0));
+        world.insertVertex(3, make_tuple(0.0, 0.0));
+        if (world.nearestVertex(-179.99, 0.0) != 2 || world.nearestVertex(179.99, 0.0) != 1
+            || world.verticesInBox(179.0, -1.0, -179.0, 1.0) != vector<int>({1, 2})) {
+            cout << "spatial index is incorrect across the antimeridian" << endl;
+        }
+        world.insertVertex(4, make_tuple(180.0, 0.0));
+        if (world.nearestVertex(-179.99, 0.0) != 4) {
+            cout << "spatial index is not rebuilt after insertVertex" << endl;
+        }
+
+        try {
+            Graph<int, string>().nearestVertex(0, 0);
+            cout << "nearestVertex of an empty graph did not throw" << endl;
+        }
+        catch (invalid_argument& e) {
+        }
+    }
+    catch (std::exception& e) {
+        cerr << "Error testing spatial index: " << e.what() << endl;
+    }
+}
+
+void test_vertexOrder()
+{
+    try{
+        Graph<int, string> g = createGraphFromFile("denison.txt");
+        CompactGraph<int, string> base = g.freeze();
+        for (VertexOrder order : {VertexOrder::Hilbert, VertexOrder::BreadthFirst, VertexOrder::CuthillMcKee}) {
+            CompactGraph<int, string> c = g.freeze(order);
+            bool same = c.numVertices() == base.numVertices() && c.numEdges() == base.numEdges();
+            vector<char> hit(c.numVertices(), 0);
+            for (uint32_t u = 0; same && u < c.numVertices(); u++) {
+                uint32_t old = g.indexOf(c.keyAt(u));
+                same = c.indexOf(c.keyAt(u)) == u && !hit[old] && c.vertexData(u) == g.vertexData(old)
+                    && c.edgesEnd(u) - c.edgesBegin(u) == g.edgesEnd(old) - g.edgesBegin(old);
+                hit[old] = 1;
+            }
+            if (!same) {
+                cout << "Reordered snapshot " << int(order) << " is not a renumbering of the graph" << endl;
+                continue;
+            }
+            int pairs[][2] = {{73712, 635949}, {91442, 70838}, {35429, 615}, {635949, 73712}};
+            for (auto& pair : pairs) {
+                for (bool weighted : {false, true}) {
+                    Path expected = base.findPath(pair[0], pair[1], weighted);
+                    Path path = c.findPath(pair[0], pair[1], weighted);
+                    if (path.found() != expected.found() || path.total() != expected.total() || path.vertices.size() != expected.vertices.size()
+                        || (path.found() && (c.keyAt(path.vertices.front()) != pair[0] || c.keyAt(path.vertices.back()) != pair[1]))) {
+                        cout << "Reordered snapshot " << int(order) << " path from " << pair[0] << " to " << pair[1] << " is incorrect" << endl;
+                    }
+                }
+            }
+            if (c.getWeight(91442, 91444) != base.getWeight(91442, 91444) || c.nearestVertex(-82.52, 40.07) != base.nearestVertex(-82.52, 40.07)) {
+                cout << "Reordered snapshot " << int(order) << " lookup is incorrect" << endl;
+            }
+        }
+
+        // on a path 0-1-2-3 added out of order, breadth-first keeps neighbors adjacent
+        Graph<int, string> chain;
+        for (int key : {2, 0, 3, 1})
+            chain.insertVertex(key, make_tuple(double(key), 0.0));
+        chain.insertEdge(0, 1, 1, "");
+        chain.insertEdge(1, 2, 1, "");
+        chain.insertEdge(2, 3, 1, "");
+        CompactGraph<int, string> bfs = chain.freeze(VertexOrder::BreadthFirst);
+        CompactGraph<int, string> rcm = chain.freeze(VertexOrder::CuthillMcKee);
+        CompactGraph<int, string> hilbert = chain.freeze(VertexOrder::Hilbert);
+        vector<int> bfsKeys, rcmKeys, hilbertKeys;
+        for (uint32_t u = 0; u < 4; u++) {
+            bfsKeys.push_back(bfs.keyAt(u));
+            rcmKeys.push_back(rcm.keyAt(u));
+            hilbertKeys.push_back(hilbert.keyAt(u));
+        }
+        if (bfsKeys != vector<int>({2, 3, 1, 0}) || rcmKeys != vector<int>({3, 2, 1, 0}) || hilbertKeys != vector<int>({0, 1, 2, 3})) {
+            cout << "Vertex orders of a chain are incorrect" << endl;
+        }
+    }
+    catch (std::exception& e) {
+        cerr << "Error testing vertex order: " << e.what() << endl;
+    }
+}
+
+void test_graphGenerator()
+{
+    try{
+        GeneratedGraph grid = gridRoadGraph(10, 10, 42);
+        vector<int> keys = grid.keys;
+        sort(keys.begin(), keys.end());
+        if (grid.keys.size() != 100 || grid.coords.size() != 100 || adjacent_find(keys.begin(), keys.end()) != keys.end()) {
+            cout << "gridRoadGraph vertices are incorrect" << endl;
+        }
+        // every edge joins neighboring intersections about 100 m apart
+        bool near = true;
+        for (const auto& edge : grid.edges) {
+            near = near && binary_search(keys.begin(), keys.end(), get<0>(edge)) && binary_search(keys.begin(), keys.end(), get<1>(edge))
+                && get<2>(edge) > 50 && get<2>(edge) < 250;
+        }
+        if (!near || grid.edges.size() < 150) {
+            cout << "gridRoadGraph edges are incorrect" << endl;
+        }
+        GeneratedGraph again = gridRoadGraph(10, 10, 42);
+        if (again.keys != grid.keys || again.edges != grid.edges) {
+            cout << "gridRoadGraph is not repeatable" << endl;
+        }
+        GeneratedGraph city = gridRoadGraph(130, 130, 42);
+        set<string> names;
+        for (const auto& edge : city.edges)
+            names.insert(get<3>(edge));
+        for (string name : {"1st Avenue", "2nd Street", "3rd Avenue", "4th Street", "11th Avenue", "12th Street", "13th Avenue"}) {
+            if (!names.count(name)) {
+                cout << "gridRoadGraph has no street named " << name << endl;
+            }
+        }
+
+        GeneratedGraph geometric = geometricRoadGraph(500, 3, 7);
+        vector<pair<int, int>> pairs;
+        for (const auto& edge : geometric.edges)
+            pairs.push_back(make_pair(get<0>(edge), get<1>(edge)));
+        sort(pairs.begin(), pairs.end());
+        if (geometric.keys.size() != 500 || adjacent_find(pairs.begin(), pairs.end()) != pairs.end() || pairs.size() < 1000) {
+            cout << "geometricRoadGraph edges are incorrect" << endl;
+        }
+
+        writeGraphText(geometric, "generator_test.txt");
+        Graph<int, string> loaded = loadGraph<int, string>("generator_test.txt");
+        Graph<int, string> built(geometric.keys, geometric.coords, geometric.edges);
+        remove("generator_test.txt");
+        if (loaded.toString() != built.toString() || loaded.getWeight(get<0>(geometric.edges[0]), get<1>(geometric.edges[0])) != get<2>(geometric.edges[0])) {
+            cout << "writeGraphText does not round trip through loadGraph" << endl;
+        }
+
+        GeneratedGraph forward = acyclicSubgraph(geometric);
+        Graph<int, string> dag(forward.keys, forward.coords, forward.edges);
+        if (dag.topologicalOrder().size() != 500) {
+            cout << "acyclicSubgraph is not acyclic" << endl;
+        }
+    }
+    catch (std::exception& e) {
+        cerr << "Error testing graph generator: " << e.what() << endl;
+    }
+}
+
+void test_queryStats()
+{
+    try{
+        Graph<int, string> g = createGraphFromFile("denison.txt");
+        SearchContext ctx;
+        QueryStats stats;
+        StatsRegistry::global().reset();
+
+        g.dijkstra(91442, ctx, stats);
+        uint64_t reached = 0, scanned = 0;
+        for (uint32_t u = 0; u < g.numVertices(); u++) {
+            if (ctx.reached(u)) {
+                reached++;
+                scanned += g.edgesEnd(u) - g.edgesBegin(u);
+            }
+        }
+        // every reached vertex is pushed, popped and settled once
+        if (stats.verticesSettled != reached || stats.heapPops != reached || stats.heapPushes != reached
+            || stats.edgesScanned != scanned || stats.relaxations != reached - 1 + stats.decreaseKeys || stats.decreaseKeys == 0) {
+            cout << "dijkstra stats are incorrect: settled " << stats.verticesSettled << " of " << reached << ", scanned "
+                 << stats.edgesScanned << " of " << scanned << ", relaxed " << stats.relaxations << endl;
+        }
+        QueryStats first = stats;
+
+        g.BFS(91442, ctx, stats);
+        if (stats.verticesSettled != reached || stats.relaxations != reached - 1 || stats.edgesScanned != scanned || stats.decreaseKeys != 0) {
+            cout << "BFS stats are incorrect" << endl;
+        }
+
+        Path path = g.findPath(73712, 635949, true, ctx, stats);
+        if (path.vertices != g.findPath(73712, 635949, true).vertices || stats.verticesSettled == 0
+            || stats.searchSeconds <= 0 || stats.pathSeconds <= 0 || stats.initializeSeconds <= 0) {
+            cout << "findPath stats are incorrect" << endl;
+        }
+        string text = g.shortestPath(73712, 635949, true, ctx, stats);
+        if (text != g.shortestPath(73712, 635949, true) || stats.verticesSettled == 0) {
+            cout << "shortestPath stats are incorrect" << endl;
+        }
+
+        StatsRegistry& registry = StatsRegistry::global();
+        if (registry.queries() != 4 || registry.totals().edgesScanned < 2 * scanned || registry.slowest().totalSeconds() < first.totalSeconds()) {
+            cout << "StatsRegistry totals are incorrect" << endl;
+        }
+        registry.reset();
+        g.findPath(73712, 635949, true);
+        if (registry.queries() != 0) {
+            cout << "Queries without stats were recorded" << endl;
+        }
+    }
+    catch (std::exception& e) {
+        cerr << "Error testing query stats: " << e.what() << endl;
+    }
+}
+
+void test_graphStorage()
+{
+    try{
+        Graph<int, string> pooled = loadGraph<int, string>("denison.txt");
+        string expected = pooled.toString();
+
+        GeneratedGraph generated = gridRoadGraph(30, 30, 5);
+        Graph<int, string> arena(generated.keys, generated.coords, generated.edges, 2, GraphStorage::Arena);
+        Graph<int, string> pool(generated.keys, generated.coords, generated.edges, 2, GraphStorage::Pool);
+        if (arena.toString() != pool.toString()) {
+            cout << "Arena and pool graphs differ" << endl;
+        }
+
+        // a copy has its own storage: changing one leaves the other alone
+        Graph<int, string> copy = pooled;
+        copy.insertEdge(91442, 70838, 1.5, "copy only");
+        if (pooled.toString() != expected || copy.getWeight(91442, 70838) != 1.5) {
+            cout << "Graph copy shares adjacency lists with the original" << endl;
+        }
+
+        // moves keep the lists with the storage they came from
+        Graph<int, string> moved = move(copy);
+        copy = pooled;
+        Graph<int, string> assigned(GraphStorage::Arena, pmr::new_delete_resource());
+        assigned.insertVertex(1, make_tuple(0.0, 0.0));
+        assigned = move(moved);
+        for (int i = 0; i < 100; i++)
+            assigned.insertEdge(91442, 91444, i, "");
+        if (copy.toString() != expected || assigned.getWeight(91442, 70838) != 1.5 || assigned.getWeight(91442, 91444) != 99) {
+            cout << "Graph move or assignment is incorrect" << endl;
+        }
+    }
+    catch (std::exception& e) {
+        cerr << "Error testing graph storage: " << e.what() << endl;
+    }
+}
+
+void test_shortestPathTree()
+{
+    try{
+        Graph<int, string> g = loadGraph<int, string>("denison.txt");
+        ShortestPathTree<int, string> tree(g, 91442);
+        SearchContext ctx;
+        mt19937 rng(11);
+        uniform_int_distribution<uint32_t> pick(0, g.numVertices() - 1);
+        uniform_real_distribution<double> scale(0.2, 3.0);
+        uint32_t touched = 0, changes = 0;
+
+        for (int round = 0; round < 20; round++) {
+            // raise and lower edges, half of them tree edges, and add a
+            // shortcut
+            for (int i = 0; i < 10; i++) {
+                uint32_t v = pick(rng);
+                uint32_t u = tree.context().getPre(v);
+                if (i % 2 && g.inEdgesBegin(v) != g.inEdgesEnd(v))
+                    u = g.inEdgeSource(g.inEdgesBegin(v));
+                if (u == NO_VERTEX)
+                    continue;
+                touched += tree.updateWeight(g.keyAt(u), g.keyAt(v), g.getWeight(g.keyAt(u), g.keyAt(v)) * scale(rng));
+                changes++;
+            }
+            uint32_t a = pick(rng), b = pick(rng);
+            tree.insertEdge(g.keyAt(a), g.keyAt(b), scale(rng) * 0.01, "shortcut");
+
+            g.dijkstra(91442, ctx);
+            for (uint32_t v = 0; v < g.numVertices(); v++) {
+                double expected = ctx.getDist(v), actual = tree.distance(g.keyAt(v));
+                uint32_t u = tree.context().getPre(v);
+                bool consistent = u == NO_VERTEX ? v == g.indexOf(91442) || actual == SearchContext::INF
+                                                 : abs(tree.context().getDist(u) + g.getWeight(g.keyAt(u), g.keyAt(v)) - actual) < 1e-9;
+                if (!(expected == actual || abs(expected - actual) < 1e-9) || !consistent) {
+                    cout << "Shortest path tree is incorrect after round " << round << " at vertex " << g.keyAt(v) << endl;
+                    return;
+                }
+            }
+        }
+        // repairs touch the affected part of the tree, not the whole graph
+        if (touched >= changes * g.numVertices() / 10) {
+            cout << "Shortest path tree repairs touched too many vertices: " << touched << endl;
+        }
+
+        Path path = tree.findPath(635949);
+        if (path.vertices.front() != g.indexOf(91442) || abs(path.distances.back() - g.findPath(91442, 635949, true).distances.back()) > 1e-9) {
+            cout << "Shortest path tree findPath is incorrect" << endl;
+        }
+
+        // vertices inserted later start unreached and join on their first edge
+        g.insertVertex(1, make_tuple(0.0, 0.0));
+        if (tree.distance(1) != SearchContext::INF || !tree.findPath(1).vertices.empty()) {
+            cout << "New vertex is reached before it has an edge" << endl;
+        }
+        tree.insertEdge(635949, 1, 2, "new");
+        if (tree.distance(1) != tree.distance(635949) + 2 || tree.findPath(1).vertices.size() < 2) {
+            cout << "New vertex is not reached through its edge" << endl;
+        }
+        // cutting its only edge leaves it unreached again
+        tree.updateWeight(635949, 1, SearchContext::INF);
+        if (tree.distance(1) != SearchContext::INF || tree.shortestPath(1) != g.shortestPath(91442, 1, true)) {
+            cout << "Vertex cut off by a weight increase is still reached" << endl;
+        }
+
+        bool threw = false;
+        try {
+            tree.updateWeight(91442, 2, 1);
+        } catch (const invalid_argument&) {
+            threw = true;
+        }
+        if (!threw) {
+            cout << "updateWeight on a missing edge did not throw" << endl;
+        }
+    }
+    catch (std::exception& e) {
+        cerr << "Error testing shortest path tree: " << e.what() << endl;
+    }
+}
+
 int main()
 {
     // test_asAdjMatrix_empty();
@@ -349,6 +1784,36 @@ int main()
     // test_asAdjMatrix_lengthFive();
     // test_asAdjMatrix_lengthOne();
     // test_shortestPath_nonexistantVertex();
+    test_freeze_shortestPath();
+    test_freeze_topologicalSort();
+    test_keyIndex();
+    test_asAdjMatrix_sparseKeys();
+    test_searchContext_reuse();
+    test_concurrent_shortestPath();
+    test_indexedHeap();
+    test_dijkstra_allDistances();
+    test_astar();
+    test_bidirectional_shortestPath();
+    test_contractionHierarchy();
+    test_threadPool();
+    test_parallel_BFS();
+    test_deltaStepping();
+    test_DFS_deepChain();
+    test_topologicalSort_kahn();
+    test_loadGraph();
+    test_saveOpen();
+    test_bulkConstructor();
+    test_labelPool();
+    test_findPath();
+    test_distanceTable();
+    test_allPairsShortestPaths();
+    test_matrixExports();
+    test_spatialIndex();
+    test_vertexOrder();
+    test_graphGenerator();
+    test_queryStats();
+    test_graphStorage();
+    test_shortestPathTree();
 
     // cout << "Testing completed" << endl;
     // ifstream infile("example.txt");
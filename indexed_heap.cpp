@@ -0,0 +1,153 @@
+//=================================================================
+// CS 271 - Project 6
+// indexed_heap.cpp
+// Fall 2025
+// This is the implementation file for the IndexedHeap class
+//=================================================================
+
+
+//=================================================================
+// before
+// Heap order: smaller priority first, ties broken by smaller index
+//   so the order in which equal entries leave the heap is fixed
+// Parameters:  a, b - entries to compare
+// Returns:     true if a must be above b
+//=================================================================
+template <class P>
+bool IndexedHeap<P>::before ( const Entry& a, const Entry& b ) const
+{
+    return a.priority < b.priority || (a.priority == b.priority && a.index < b.index);
+}
+
+//=================================================================
+// place
+// Stores an entry at a heap position and records that position
+// Parameters:  i - heap position
+//              entry - entry to store
+// Returns:     none
+//=================================================================
+template <class P>
+void IndexedHeap<P>::place ( size_t i, const Entry& entry )
+{
+    heap[i] = entry;
+    pos[entry.index] = i;
+}
+
+//=================================================================
+// siftUp
+// Moves the entry at position i up until its parent is not larger
+// Parameters:  i - heap position
+// Returns:     none
+//=================================================================
+template <class P>
+void IndexedHeap<P>::siftUp ( size_t i )
+{
+    Entry entry = heap[i];
+    while (i > 0) {
+        size_t parent = (i - 1) / ARITY;
+        if (!before(entry, heap[parent]))
+            break;
+        place(i, heap[parent]);
+        i = parent;
+    }
+    place(i, entry);
+}
+
+//=================================================================
+// siftDown
+// Moves the entry at position i down until no child is smaller
+// Parameters:  i - heap position
+// Returns:     none
+//=================================================================
+template <class P>
+void IndexedHeap<P>::siftDown ( size_t i )
+{
+    Entry entry = heap[i];
+    size_t n = heap.size();
+    while (true) {
+        size_t first = i * ARITY + 1;
+        if (first >= n)
+            break;
+        size_t last = first + ARITY < n ? first + ARITY : n;
+        size_t best = first;
+        for (size_t c = first + 1; c < last; c++) {
+            if (before(heap[c], heap[best]))
+                best = c;
+        }
+        if (!before(heap[best], entry))
+            break;
+        place(i, heap[best]);
+        i = best;
+    }
+    place(i, entry);
+}
+
+//=================================================================
+// resize
+// Makes room for vertex indices 0..n-1
+// Parameters:  n - number of vertices
+// Returns:     none
+//=================================================================
+template <class P>
+void IndexedHeap<P>::resize ( uint32_t n )
+{
+    if (n > pos.size())
+        pos.resize(n, NOT_IN_HEAP);
+}
+
+//=================================================================
+// push
+// Inserts v, or lowers its priority if it is already in the heap
+//   (decrease-key). A larger priority for a present v is ignored.
+// Parameters:  v - vertex index
+//              priority - new priority of v
+// Returns:     none
+//=================================================================
+template <class P>
+void IndexedHeap<P>::push ( uint32_t v, P priority )
+{
+    if (contains(v)) {
+        size_t i = pos[v];
+        if (!(priority < heap[i].priority))
+            return;
+        heap[i].priority = priority;
+        siftUp(i);
+    } else {
+        heap.push_back(Entry{priority, v});
+        siftUp(heap.size() - 1);
+    }
+}
+
+//=================================================================
+// pop
+// Removes the minimum entry
+// Parameters:  none
+// Returns:     vertex index of the removed entry
+//=================================================================
+template <class P>
+uint32_t IndexedHeap<P>::pop ( )
+{
+    uint32_t v = heap[0].index;
+    pos[v] = NOT_IN_HEAP;
+    Entry last = heap.back();
+    heap.pop_back();
+    if (!heap.empty()) {
+        heap[0] = last;
+        siftDown(0);
+    }
+    return v;
+}
+
+//=================================================================
+// clear
+// Empties the heap in time proportional to its current size
+// Parameters:  none
+// Returns:     none
+//=================================================================
+template <class P>
+void IndexedHeap<P>::clear ( )
+{
+    for (const Entry& entry : heap)
+        pos[entry.index] = NOT_IN_HEAP;
+    heap.clear();
+}
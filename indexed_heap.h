@@ -0,0 +1,48 @@
+//=================================================================
+// CS 271 - Project 6
+// indexed_heap.h
+// Fall 2025
+// This is the declaration file for the IndexedHeap class, a 4-ary
+// min-heap of (priority, vertex index) pairs with decrease-key
+//=================================================================
+
+#ifndef INDEXED_HEAP_H
+#define INDEXED_HEAP_H
+
+#include <vector>
+#include <cstdint>
+using namespace std;
+
+template <class P>
+class IndexedHeap
+{
+private:
+   struct Entry
+   {
+       P          priority;
+       uint32_t   index;
+   };
+
+   static constexpr size_t ARITY = 4;
+   static constexpr uint32_t NOT_IN_HEAP = UINT32_MAX;
+
+   vector<Entry>      heap;   // heap[0] is the minimum
+   vector<uint32_t>   pos;    // pos[v] is where v sits in heap, or NOT_IN_HEAP
+
+   bool     before      ( const Entry& a, const Entry& b ) const;
+   void     place       ( size_t i, const Entry& entry );
+   void     siftUp      ( size_t i );
+   void     siftDown    ( size_t i );
+public:
+   void     resize      ( uint32_t n );
+   bool     empty       ( ) const { return heap.empty(); }
+   size_t   size        ( ) const { return heap.size(); }
+   bool     contains    ( uint32_t v ) const { return v < pos.size() && pos[v] != NOT_IN_HEAP; }
+   uint32_t top         ( ) const { return heap[0].index; }
+   P        topPriority ( ) const { return heap[0].priority; }
+   void     push        ( uint32_t v, P priority );
+   uint32_t pop         ( );
+   void     clear       ( );
+};
+#include "indexed_heap.cpp"
+#endif
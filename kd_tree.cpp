@@ -0,0 +1,349 @@
+//=================================================================
+// CS 271 - Project 6
+// kd_tree.cpp
+// Fall 2025
+// This is the implementation file for the KdTree class
+//=================================================================
+
+#include <cmath>
+#include <algorithm>
+
+
+//=================================================================
+// Default constructor
+// Creates an empty index
+// Parameters:  none
+// Returns:     none
+//=================================================================
+inline KdTree::KdTree ( )
+{
+}
+
+//=================================================================
+// Constructor
+// Indexes a list of points
+// Parameters:  points - (longitude, latitude) of point i, in degrees
+// Returns:     none
+//=================================================================
+inline KdTree::KdTree ( const vector<tuple<double, double>>& points )
+{
+    nodes.resize(points.size());
+    for (uint32_t i = 0; i < points.size(); i++) {
+        Node& node = nodes[i];
+        node.lon = get<0>(points[i]);
+        node.lat = get<1>(points[i]);
+        node.vertex = i;
+        toUnit(node.lon, node.lat, node.p);
+    }
+    build(0, nodes.size());
+}
+
+//=================================================================
+// Constructor
+// Indexes the coordinates of every vertex of a graph
+// Parameters:  g - graph with numVertices() and vertexData(u)
+// Returns:     none
+//=================================================================
+template <class G>
+KdTree::KdTree ( const G& g )
+{
+    nodes.resize(g.numVertices());
+    for (uint32_t u = 0; u < nodes.size(); u++) {
+        tuple<double, double> data = g.vertexData(u);
+        Node& node = nodes[u];
+        node.lon = get<0>(data);
+        node.lat = get<1>(data);
+        node.vertex = u;
+        toUnit(node.lon, node.lat, node.p);
+    }
+    build(0, nodes.size());
+}
+
+//=================================================================
+// toUnit
+// Converts a coordinate to a point on the unit sphere
+// Parameters:  lon, lat - coordinate in degrees
+//              p - receives x, y, z
+// Returns:     none
+//=================================================================
+inline void KdTree::toUnit ( double lon, double lat, double* p )
+{
+    const double RAD = M_PI / 180.0;
+    p[0] = cos(lat * RAD) * cos(lon * RAD);
+    p[1] = cos(lat * RAD) * sin(lon * RAD);
+    p[2] = sin(lat * RAD);
+}
+
+//=================================================================
+// build
+// Arranges nodes[lo, hi) into a subtree: splits on the coordinate
+//   of widest spread at the median, then fills in the bounds
+// Parameters:  lo, hi - range of nodes
+// Returns:     none
+//=================================================================
+inline void KdTree::build ( uint32_t lo, uint32_t hi )
+{
+    if (lo >= hi)
+        return;
+    double low[3] = {2, 2, 2};
+    double high[3] = {-2, -2, -2};
+    for (uint32_t i = lo; i < hi; i++) {
+        for (int a = 0; a < 3; a++) {
+            low[a] = min(low[a], nodes[i].p[a]);
+            high[a] = max(high[a], nodes[i].p[a]);
+        }
+    }
+    uint32_t axis = 0;
+    for (uint32_t a = 1; a < 3; a++) {
+        if (high[a] - low[a] > high[axis] - low[axis])
+            axis = a;
+    }
+
+    uint32_t mid = lo + (hi - lo) / 2;
+    nth_element(nodes.begin() + lo, nodes.begin() + mid, nodes.begin() + hi, [axis](const Node& x, const Node& y) {
+        return x.p[axis] < y.p[axis] || (x.p[axis] == y.p[axis] && x.vertex < y.vertex);
+    });
+    build(lo, mid);
+    build(mid + 1, hi);
+
+    Node& node = nodes[mid];
+    node.axis = axis;
+    node.minLon = node.maxLon = node.lon;
+    node.minLat = node.maxLat = node.lat;
+    if (lo < mid)
+        widen(node, nodes[lo + (mid - lo) / 2]);
+    if (mid + 1 < hi)
+        widen(node, nodes[mid + 1 + (hi - mid - 1) / 2]);
+}
+
+//=================================================================
+// widen
+// Grows the bounds of a node to cover a child subtree
+// Parameters:  node - the node
+//              child - root of the child subtree
+// Returns:     none
+//=================================================================
+inline void KdTree::widen ( Node& node, const Node& child )
+{
+    node.minLon = min(node.minLon, child.minLon);
+    node.maxLon = max(node.maxLon, child.maxLon);
+    node.minLat = min(node.minLat, child.minLat);
+    node.maxLat = max(node.maxLat, child.maxLat);
+}
+
+//=================================================================
+// distance2
+// Squared chord distance between two unit vectors
+//=================================================================
+inline double distance2 ( const double* a, const double* b )
+{
+    double dx = a[0] - b[0];
+    double dy = a[1] - b[1];
+    double dz = a[2] - b[2];
+    return dx * dx + dy * dy + dz * dz;
+}
+
+//=================================================================
+// nearest
+// The closest point to a coordinate by great-circle distance, ties
+//   going to the lower index
+// Parameters:  lon, lat - coordinate in degrees
+// Returns:     index of the point, NO_VERTEX if the tree is empty
+//=================================================================
+inline uint32_t KdTree::nearest ( double lon, double lat ) const
+{
+    double q[3];
+    toUnit(lon, lat, q);
+    double best = INFINITY;
+    uint32_t found = NO_VERTEX;
+    nearestIn(0, nodes.size(), q, best, found);
+    return found;
+}
+
+//=================================================================
+// nearestIn
+// nearest restricted to the subtree over nodes[lo, hi)
+// Parameters:  lo, hi - range of nodes
+//              q - query unit vector
+//              best - squared distance of the best point so far
+//              found - index of the best point so far
+// Returns:     none
+//=================================================================
+inline void KdTree::nearestIn ( uint32_t lo, uint32_t hi, const double* q, double& best, uint32_t& found ) const
+{
+    if (lo >= hi)
+        return;
+    uint32_t mid = lo + (hi - lo) / 2;
+    const Node& node = nodes[mid];
+    double d = distance2(q, node.p);
+    if (d < best || (d == best && node.vertex < found)) {
+        best = d;
+        found = node.vertex;
+    }
+    double diff = q[node.axis] - node.p[node.axis];
+    if (diff < 0) {
+        nearestIn(lo, mid, q, best, found);
+        if (diff * diff <= best)
+            nearestIn(mid + 1, hi, q, best, found);
+    } else {
+        nearestIn(mid + 1, hi, q, best, found);
+        if (diff * diff <= best)
+            nearestIn(lo, mid, q, best, found);
+    }
+}
+
+//=================================================================
+// nearest
+// The k closest points to a coordinate
+// Parameters:  lon, lat - coordinate in degrees
+//              k - number of points wanted
+// Returns:     indices of up to k points, closest first
+//=================================================================
+inline vector<uint32_t> KdTree::nearest ( double lon, double lat, uint32_t k ) const
+{
+    double q[3];
+    toUnit(lon, lat, q);
+    vector<pair<double, uint32_t>> heap;
+    if (k > 0)
+        kNearestIn(0, nodes.size(), q, k, heap);
+    sort_heap(heap.begin(), heap.end());
+    vector<uint32_t> result;
+    for (const auto& entry : heap)
+        result.push_back(entry.second);
+    return result;
+}
+
+//=================================================================
+// kNearestIn
+// k nearest restricted to the subtree over nodes[lo, hi)
+// Parameters:  lo, hi - range of nodes
+//              q - query unit vector
+//              k - number of points wanted
+//              heap - max-heap of the best (squared distance, index)
+// Returns:     none
+//=================================================================
+inline void KdTree::kNearestIn ( uint32_t lo, uint32_t hi, const double* q, uint32_t k, vector<pair<double, uint32_t>>& heap ) const
+{
+    if (lo >= hi)
+        return;
+    uint32_t mid = lo + (hi - lo) / 2;
+    const Node& node = nodes[mid];
+    pair<double, uint32_t> entry(distance2(q, node.p), node.vertex);
+    if (heap.size() < k) {
+        heap.push_back(entry);
+        push_heap(heap.begin(), heap.end());
+    } else if (entry < heap.front()) {
+        pop_heap(heap.begin(), heap.end());
+        heap.back() = entry;
+        push_heap(heap.begin(), heap.end());
+    }
+    double diff = q[node.axis] - node.p[node.axis];
+    uint32_t nearLo = diff < 0 ? lo : mid + 1;
+    uint32_t nearHi = diff < 0 ? mid : hi;
+    uint32_t farLo = diff < 0 ? mid + 1 : lo;
+    uint32_t farHi = diff < 0 ? hi : mid;
+    kNearestIn(nearLo, nearHi, q, k, heap);
+    if (heap.size() < k || diff * diff <= heap.front().first)
+        kNearestIn(farLo, farHi, q, k, heap);
+}
+
+//=================================================================
+// within
+// Every point within a great-circle distance of a coordinate
+// Parameters:  lon, lat - coordinate in degrees
+//              meters - the distance
+// Returns:     indices of the points, closest first
+//=================================================================
+inline vector<uint32_t> KdTree::within ( double lon, double lat, double meters ) const
+{
+    const double EARTH_RADIUS = 6371008.8;   // as in haversineDistance
+    double q[3];
+    toUnit(lon, lat, q);
+    double angle = min(max(meters, 0.0) / EARTH_RADIUS, M_PI);
+    double chord = 2 * sin(angle / 2);
+    vector<pair<double, uint32_t>> found;
+    withinIn(0, nodes.size(), q, chord * chord, found);
+    sort(found.begin(), found.end());
+    vector<uint32_t> result;
+    for (const auto& entry : found)
+        result.push_back(entry.second);
+    return result;
+}
+
+//=================================================================
+// withinIn
+// within restricted to the subtree over nodes[lo, hi)
+// Parameters:  lo, hi - range of nodes
+//              q - query unit vector
+//              limit - largest squared chord distance accepted
+//              out - receives (squared distance, index) of matches
+// Returns:     none
+//=================================================================
+inline void KdTree::withinIn ( uint32_t lo, uint32_t hi, const double* q, double limit, vector<pair<double, uint32_t>>& out ) const
+{
+    if (lo >= hi)
+        return;
+    uint32_t mid = lo + (hi - lo) / 2;
+    const Node& node = nodes[mid];
+    double d = distance2(q, node.p);
+    if (d <= limit)
+        out.push_back(make_pair(d, node.vertex));
+    double diff = q[node.axis] - node.p[node.axis];
+    if (diff < 0 || diff * diff <= limit)
+        withinIn(lo, mid, q, limit, out);
+    if (diff >= 0 || diff * diff <= limit)
+        withinIn(mid + 1, hi, q, limit, out);
+}
+
+//=================================================================
+// lonInRange
+// Whether a longitude lies in [minLon, maxLon], where minLon >
+//   maxLon means the range crosses the antimeridian
+//=================================================================
+inline bool lonInRange ( double lon, double minLon, double maxLon )
+{
+    return minLon <= maxLon ? (lon >= minLon && lon <= maxLon) : (lon >= minLon || lon <= maxLon);
+}
+
+//=================================================================
+// inBox
+// Every point inside a longitude/latitude box. A box with minLon
+//   greater than maxLon wraps across the antimeridian.
+// Parameters:  minLon, minLat, maxLon, maxLat - the box in degrees
+// Returns:     indices of the points in increasing order
+//=================================================================
+inline vector<uint32_t> KdTree::inBox ( double minLon, double minLat, double maxLon, double maxLat ) const
+{
+    vector<uint32_t> result;
+    inBoxIn(0, nodes.size(), minLon, minLat, maxLon, maxLat, result);
+    sort(result.begin(), result.end());
+    return result;
+}
+
+//=================================================================
+// inBoxIn
+// inBox restricted to the subtree over nodes[lo, hi), skipping
+//   subtrees whose bounds miss the box
+// Parameters:  lo, hi - range of nodes
+//              minLon, minLat, maxLon, maxLat - the box in degrees
+//              out - receives the indices of matches
+// Returns:     none
+//=================================================================
+inline void KdTree::inBoxIn ( uint32_t lo, uint32_t hi, double minLon, double minLat, double maxLon, double maxLat,
+                              vector<uint32_t>& out ) const
+{
+    if (lo >= hi)
+        return;
+    uint32_t mid = lo + (hi - lo) / 2;
+    const Node& node = nodes[mid];
+    if (node.maxLat < minLat || node.minLat > maxLat)
+        return;
+    bool lonOverlap = minLon <= maxLon ? (node.maxLon >= minLon && node.minLon <= maxLon)
+                                       : (node.maxLon >= minLon || node.minLon <= maxLon);
+    if (!lonOverlap)
+        return;
+    if (node.lat >= minLat && node.lat <= maxLat && lonInRange(node.lon, minLon, maxLon))
+        out.push_back(node.vertex);
+    inBoxIn(lo, mid, minLon, minLat, maxLon, maxLat, out);
+    inBoxIn(mid + 1, hi, minLon, minLat, maxLon, maxLat, out);
+}
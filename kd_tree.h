@@ -0,0 +1,64 @@
+//=================================================================
+// CS 271 - Project 6
+// kd_tree.h
+// Fall 2025
+// This is the declaration file for the KdTree class, a spatial index
+// of vertex coordinates for nearest-vertex lookups
+//=================================================================
+
+#ifndef KD_TREE_H
+#define KD_TREE_H
+
+#include <vector>
+#include <tuple>
+#include <cstdint>
+#include "key_index.h"
+using namespace std;
+
+// Points are (longitude, latitude) in degrees. Each is stored as a
+// unit vector in 3D, where straight-line (chord) distance grows with
+// great-circle distance, so the nearest point in the tree is exactly
+// the nearest on the earth, with no projection error near the poles
+// or the antimeridian. The tree is implicit: the subtree over
+// nodes[lo, hi) has its root at (lo + hi) / 2. Each node also keeps
+// the longitude/latitude bounds of its subtree for box queries.
+class KdTree
+{
+private:
+   struct Node
+   {
+       double     p[3];      // unit vector of the point
+       double     lon;
+       double     lat;
+       double     minLon;    // bounds of the subtree rooted here
+       double     maxLon;
+       double     minLat;
+       double     maxLat;
+       uint32_t   vertex;
+       uint32_t   axis;      // 0, 1 or 2: coordinate split on
+   };
+
+   vector<Node>   nodes;
+
+   void     build       ( uint32_t lo, uint32_t hi );
+   void     nearestIn   ( uint32_t lo, uint32_t hi, const double* q, double& best, uint32_t& found ) const;
+   void     kNearestIn  ( uint32_t lo, uint32_t hi, const double* q, uint32_t k, vector<pair<double, uint32_t>>& heap ) const;
+   void     withinIn    ( uint32_t lo, uint32_t hi, const double* q, double limit, vector<pair<double, uint32_t>>& out ) const;
+   void     inBoxIn     ( uint32_t lo, uint32_t hi, double minLon, double minLat, double maxLon, double maxLat,
+                          vector<uint32_t>& out ) const;
+   static void widen    ( Node& node, const Node& child );
+   static void toUnit   ( double lon, double lat, double* p );
+public:
+            KdTree      ( );
+            KdTree      ( const vector<tuple<double, double>>& points );
+   template <class G>
+   explicit KdTree      ( const G& g );
+
+   uint32_t size        ( ) const { return nodes.size(); }
+   uint32_t nearest     ( double lon, double lat ) const;
+   vector<uint32_t> nearest ( double lon, double lat, uint32_t k ) const;
+   vector<uint32_t> within  ( double lon, double lat, double meters ) const;
+   vector<uint32_t> inBox   ( double minLon, double minLat, double maxLon, double maxLat ) const;
+};
+#include "kd_tree.cpp"
+#endif
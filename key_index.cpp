@@ -0,0 +1,139 @@
+//=================================================================
+// CS 271 - Project 6
+// key_index.cpp
+// Fall 2025
+// This is the implementation file for the KeyIndex class
+//=================================================================
+
+
+//=================================================================
+// Default constructor
+// Creates an empty index with a small table
+// Parameters:  none
+// Returns:     none
+//=================================================================
+template <class K>
+KeyIndex<K>::KeyIndex ( )
+{
+    count = 0;
+    rehash(16);
+}
+
+//=================================================================
+// slotFor
+// Home slot of a key. std::hash is the identity for integers, so
+//   the hash is scrambled with a Fibonacci multiply and the high
+//   bits are used; otherwise sequential keys would cluster.
+// Parameters:  key - the key to place
+// Returns:     index of the first slot to probe
+//=================================================================
+template <class K>
+size_t KeyIndex<K>::slotFor ( const K& key ) const
+{
+    uint64_t h = hash<K>()(key);
+    return (h * 0x9E3779B97F4A7C15ull) >> shift;
+}
+
+//=================================================================
+// rehash
+// Moves every key into a new table of the given capacity
+// Parameters:  capacity - new number of slots (a power of two)
+// Returns:     none
+//=================================================================
+template <class K>
+void KeyIndex<K>::rehash ( size_t capacity )
+{
+    vector<Slot> table(capacity, Slot{K(), NO_VERTEX});
+
+    shift = 64;
+    for (size_t c = capacity; c > 1; c >>= 1)
+        shift--;
+
+    size_t mask = capacity - 1;
+    for (const Slot& slot : slots) {
+        if (slot.index == NO_VERTEX)
+            continue;
+        size_t i = slotFor(slot.key);
+        while (table[i].index != NO_VERTEX)
+            i = (i + 1) & mask;
+        table[i] = slot;
+    }
+    slots.adopt(move(table));
+}
+
+//=================================================================
+// view
+// Uses a table laid out by another KeyIndex (e.g. in a mapped file)
+//   without copying it. Inserting later copies the table first.
+// Parameters:  table - the slots
+//              capacity - number of slots, a power of two
+//              count - number of keys in the table
+// Returns:     none
+//=================================================================
+template <class K>
+void KeyIndex<K>::view ( const Slot* table, uint32_t capacity, uint32_t count )
+{
+    slots.view(table, capacity);
+    this->count = count;
+    shift = 64;
+    for (size_t c = capacity; c > 1; c >>= 1)
+        shift--;
+}
+
+//=================================================================
+// find
+// Looks up the index of a key with linear probing
+// Parameters:  key - the key to look up
+// Returns:     index stored for the key, NO_VERTEX if absent
+//=================================================================
+template <class K>
+uint32_t KeyIndex<K>::find ( const K& key ) const
+{
+    size_t mask = slots.size() - 1;
+    for (size_t i = slotFor(key); slots[i].index != NO_VERTEX; i = (i + 1) & mask) {
+        if (slots[i].key == key)
+            return slots[i].index;
+    }
+    return NO_VERTEX;
+}
+
+//=================================================================
+// insert
+// Adds a key if it is not already present. The table is kept at
+//   most half full so probe sequences stay short.
+// Parameters:  key   - the key to add
+//              index - index to store for a new key
+// Returns:     the index stored for the key (the old one if present)
+//=================================================================
+template <class K>
+uint32_t KeyIndex<K>::insert ( const K& key, uint32_t index )
+{
+    if (2 * (count + 1) > slots.size())
+        rehash(2 * slots.size());
+
+    size_t mask = slots.size() - 1;
+    size_t i = slotFor(key);
+    for ( ; slots[i].index != NO_VERTEX; i = (i + 1) & mask) {
+        if (slots[i].key == key)
+            return slots[i].index;
+    }
+    slots.edit()[i] = Slot{key, index};
+    count++;
+    return index;
+}
+
+//=================================================================
+// reserve
+// Grows the table so n keys fit without further rehashing
+// Parameters:  n - expected number of keys
+// Returns:     none
+//=================================================================
+template <class K>
+void KeyIndex<K>::reserve ( uint32_t n )
+{
+    size_t capacity = slots.size();
+    while (capacity < 2 * (size_t)n)
+        capacity *= 2;
+    if (capacity != slots.size())
+        rehash(capacity);
+}
@@ -0,0 +1,51 @@
+//=================================================================
+// CS 271 - Project 6
+// key_index.h
+// Fall 2025
+// This is the declaration file for the KeyIndex class, an
+// open-addressing hash table mapping vertex keys to dense indices
+//=================================================================
+
+#ifndef KEY_INDEX_H
+#define KEY_INDEX_H
+
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include "mapped_file.h"
+using namespace std;
+
+// Sentinel index meaning "no vertex" (e.g. no predecessor)
+const uint32_t NO_VERTEX = UINT32_MAX;
+
+template <class K>
+class KeyIndex
+{
+public:
+   struct Slot
+   {
+       K          key;
+       uint32_t   index;   // NO_VERTEX marks an empty slot
+   };
+private:
+   MappedArray<Slot> slots; // capacity is always a power of two
+   uint32_t       count;   // number of keys stored
+   int            shift;   // 64 - log2(capacity), used by slotFor
+
+   size_t   slotFor     ( const K& key ) const;
+   void     rehash      ( size_t capacity );
+public:
+            KeyIndex    ( );
+
+   uint32_t find        ( const K& key ) const;
+   uint32_t insert      ( const K& key, uint32_t index );
+   void     reserve     ( uint32_t n );
+   uint32_t size        ( ) const { return count; }
+
+   // raw table, so a saved index can be used in place (see CompactGraph::save)
+   const Slot* table    ( ) const { return slots.data(); }
+   uint32_t capacity    ( ) const { return slots.size(); }
+   void     view        ( const Slot* table, uint32_t capacity, uint32_t count );
+};
+#include "key_index.cpp"
+#endif
@@ -0,0 +1,62 @@
+//=================================================================
+// CS 271 - Project 6
+// label_pool.cpp
+// Fall 2025
+// This is the implementation file for the LabelPool class
+//=================================================================
+
+
+//=================================================================
+// Default constructor
+// Creates a pool holding only the empty label
+// Parameters:  none
+// Returns:     none
+//=================================================================
+inline LabelPool::LabelPool ( )
+{
+    intern("");
+}
+
+//=================================================================
+// Copy constructor
+// Copies the texts; the lookup table is rebuilt so that its keys
+//   view the copy's texts, not other's
+// Parameters:  other - pool to copy
+// Returns:     none
+//=================================================================
+inline LabelPool::LabelPool ( const LabelPool& other ) : texts(other.texts)
+{
+    ids.reserve(texts.size());
+    for (uint32_t id = 0; id < texts.size(); id++)
+        ids.emplace(texts[id], id);
+}
+
+//=================================================================
+// Assignment operator
+// Same as the copy constructor, replacing this pool's labels
+// Parameters:  other - pool to copy
+// Returns:     this pool
+//=================================================================
+inline LabelPool& LabelPool::operator= ( const LabelPool& other )
+{
+    if (this != &other)
+        *this = LabelPool(other);
+    return *this;
+}
+
+//=================================================================
+// intern
+// Finds the id of a label, adding the label if it is new
+// Parameters:  label - text of the label
+// Returns:     id of the label
+//=================================================================
+inline uint32_t LabelPool::intern ( string_view label )
+{
+    auto found = ids.find(label);
+    if (found != ids.end())
+        return found->second;
+    uint32_t id = texts.size();
+    texts.emplace_back(label);
+    ids.emplace(texts.back(), id);
+    return id;
+}
@@ -0,0 +1,40 @@
+//=================================================================
+// CS 271 - Project 6
+// label_pool.h
+// Fall 2025
+// This is the declaration file for the LabelPool class, a table of
+// distinct edge labels shared by all edges of a graph
+//=================================================================
+
+#ifndef LABEL_POOL_H
+#define LABEL_POOL_H
+
+#include <string>
+#include <string_view>
+#include <deque>
+#include <unordered_map>
+#include <cstdint>
+using namespace std;
+
+// Each distinct label is stored once and edges refer to it by a
+// 32-bit id. Id 0 is always the empty label. The lookup table keys
+// are views of the stored texts, which a deque never moves, so the
+// text itself is not stored a second time.
+class LabelPool
+{
+private:
+   deque<string>                         texts;  // id -> label
+   unordered_map<string_view, uint32_t>  ids;    // label -> id, viewing texts
+public:
+                  LabelPool ( );
+                  LabelPool ( const LabelPool& other );
+                  LabelPool ( LabelPool&& other ) = default;
+   LabelPool&     operator= ( const LabelPool& other );
+   LabelPool&     operator= ( LabelPool&& other ) = default;
+
+   uint32_t       intern    ( string_view label );
+   const string&  text      ( uint32_t id ) const { return texts[id]; }
+   uint32_t       size      ( ) const { return texts.size(); }
+};
+#include "label_pool.cpp"
+#endif
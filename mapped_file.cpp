@@ -0,0 +1,142 @@
+//=================================================================
+// CS 271 - Project 6
+// mapped_file.cpp
+// Fall 2025
+// This is the implementation file for the MappedFile and
+// MappedArray classes
+//=================================================================
+
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+//=================================================================
+// MappedFile constructor
+// Maps the whole file into memory, read-only
+// Parameters:  filename - path of the file
+// Returns:     none
+// Throws:      runtime_error if the file cannot be opened or mapped
+//=================================================================
+inline MappedFile::MappedFile ( const string& filename ) : bytes(nullptr), length(0)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw runtime_error("Error opening file: " + filename);
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw runtime_error("Error reading file: " + filename);
+    }
+    length = info.st_size;
+    if (length > 0) {
+        void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            close(fd);
+            throw runtime_error("Error mapping file: " + filename);
+        }
+        bytes = static_cast<const char*>(mapped);
+    }
+    close(fd);
+}
+
+//=================================================================
+// MappedFile destructor
+// Unmaps the file
+// Parameters:  none
+// Returns:     none
+//=================================================================
+inline MappedFile::~MappedFile ( )
+{
+    if (bytes != nullptr)
+        munmap(const_cast<char*>(bytes), length);
+}
+
+//=================================================================
+// MappedArray default constructor
+// Creates an empty array
+// Parameters:  none
+// Returns:     none
+//=================================================================
+template <class T>
+MappedArray<T>::MappedArray ( ) : items(nullptr), count(0), viewing(false)
+{
+}
+
+//=================================================================
+// MappedArray copy constructor
+// Copies owned elements; a copy of a view views the same memory
+// Parameters:  other - the array to copy
+// Returns:     none
+//=================================================================
+template <class T>
+MappedArray<T>::MappedArray ( const MappedArray& other )
+    : owned(other.owned), items(other.viewing ? other.items : owned.data()), count(other.count), viewing(other.viewing)
+{
+}
+
+//=================================================================
+// operator=
+// Replaces the contents with a copy of (or the moved) other
+// Parameters:  other - the array to take over
+// Returns:     this array
+//=================================================================
+template <class T>
+MappedArray<T>& MappedArray<T>::operator= ( MappedArray other )
+{
+    // moving a vector keeps its buffer, so items stays valid
+    owned = move(other.owned);
+    items = other.items;
+    count = other.count;
+    viewing = other.viewing;
+    return *this;
+}
+
+//=================================================================
+// adopt
+// Takes ownership of the given elements
+// Parameters:  elements - the new contents
+// Returns:     none
+//=================================================================
+template <class T>
+void MappedArray<T>::adopt ( vector<T>&& elements )
+{
+    owned = move(elements);
+    items = owned.data();
+    count = owned.size();
+    viewing = false;
+}
+
+//=================================================================
+// view
+// Makes the array read n elements from memory it does not own
+// Parameters:  elements - first element
+//              n - number of elements
+// Returns:     none
+//=================================================================
+template <class T>
+void MappedArray<T>::view ( const T* elements, size_t n )
+{
+    vector<T>().swap(owned);
+    items = elements;
+    count = n;
+    viewing = true;
+}
+
+//=================================================================
+// edit
+// Gives write access to the elements, first copying them out of
+//   the viewed memory if this is a view
+// Parameters:  none
+// Returns:     the first element
+//=================================================================
+template <class T>
+T* MappedArray<T>::edit ( )
+{
+    if (viewing)
+        adopt(vector<T>(items, items + count));
+    return owned.data();
+}
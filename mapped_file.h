@@ -0,0 +1,64 @@
+//=================================================================
+// CS 271 - Project 6
+// mapped_file.h
+// Fall 2025
+// This is the declaration file for the MappedFile class, a read-only
+// memory mapping of a file, and the MappedArray class, an array that
+// either owns its elements or reads them from such a mapping
+//=================================================================
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+using namespace std;
+
+// A read-only memory mapping of a whole file, unmapped on destruction
+class MappedFile
+{
+private:
+   const char*  bytes;
+   size_t       length;
+public:
+   explicit     MappedFile  ( const string& filename );
+               ~MappedFile  ( );
+                MappedFile  ( const MappedFile& ) = delete;
+   MappedFile&  operator=   ( const MappedFile& ) = delete;
+
+   const char*  data        ( ) const { return bytes; }
+   size_t       size        ( ) const { return length; }
+};
+
+// Read access is the same either way. A view does not keep the memory
+// alive; whoever creates it also holds on to the mapping. Copying a
+// view copies only the pointer.
+template <class T>
+class MappedArray
+{
+private:
+   vector<T>    owned;    // the elements, unless this is a view
+   const T*     items;    // owned.data() or the viewed memory
+   size_t       count;
+   bool         viewing;
+public:
+                MappedArray ( );
+                MappedArray ( const MappedArray& other );
+                MappedArray ( MappedArray&& other ) = default;
+   MappedArray& operator=   ( MappedArray other );
+
+   void         adopt       ( vector<T>&& elements );
+   void         view        ( const T* elements, size_t n );
+   T*           edit        ( );
+
+   size_t       size        ( ) const { return count; }
+   bool         empty       ( ) const { return count == 0; }
+   const T*     data        ( ) const { return items; }
+   const T*     begin       ( ) const { return items; }
+   const T*     end         ( ) const { return items + count; }
+   const T&     operator[]  ( size_t i ) const { return items[i]; }
+   const T&     back        ( ) const { return items[count - 1]; }
+};
+#include "mapped_file.cpp"
+#endif
@@ -0,0 +1,35 @@
+//=================================================================
+// CS 271 - Project 6
+// matrix.cpp
+// Fall 2025
+// This is the implementation file for the Matrix class
+//=================================================================
+
+
+//=================================================================
+// Default constructor
+// Creates a 0 x 0 matrix
+// Parameters:  none
+// Returns:     none
+//=================================================================
+template <class T>
+Matrix<T>::Matrix ( )
+{
+    numRows = 0;
+    numCols = 0;
+}
+
+//=================================================================
+// Constructor
+// Creates a matrix with every cell set to one value
+// Parameters:  rows - number of rows
+//              cols - number of columns
+//              value - initial value of every cell
+// Returns:     none
+//=================================================================
+template <class T>
+Matrix<T>::Matrix ( uint32_t rows, uint32_t cols, const T& value ) : cells(size_t(rows) * cols, value)
+{
+    numRows = rows;
+    numCols = cols;
+}
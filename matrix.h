@@ -0,0 +1,59 @@
+//=================================================================
+// CS 271 - Project 6
+// matrix.h
+// Fall 2025
+// This is the declaration file for the Matrix class, a dense
+// row-major table of values
+//=================================================================
+
+#ifndef MATRIX_H
+#define MATRIX_H
+
+#include <vector>
+#include <cstdint>
+#include <new>
+using namespace std;
+
+// Allocator whose blocks start on a cache line
+template <class T>
+struct CacheAligned
+{
+    typedef T value_type;
+    static constexpr size_t ALIGNMENT = 64;
+
+    CacheAligned ( ) { }
+    template <class U>
+    CacheAligned ( const CacheAligned<U>& ) { }
+
+    T*   allocate   ( size_t n ) { return static_cast<T*>(::operator new(n * sizeof(T), align_val_t(ALIGNMENT))); }
+    void deallocate ( T* p, size_t ) { ::operator delete(p, align_val_t(ALIGNMENT)); }
+
+    template <class U>
+    bool operator== ( const CacheAligned<U>& ) const { return true; }
+    template <class U>
+    bool operator!= ( const CacheAligned<U>& ) const { return false; }
+};
+
+// Row r occupies data()[r * cols() .. (r + 1) * cols()), and data()
+// starts on a cache line.
+template <class T>
+class Matrix
+{
+private:
+   vector<T, CacheAligned<T>> cells;
+   uint32_t   numRows;
+   uint32_t   numCols;
+public:
+              Matrix      ( );
+              Matrix      ( uint32_t rows, uint32_t cols, const T& value = T() );
+
+   uint32_t   rows        ( ) const { return numRows; }
+   uint32_t   cols        ( ) const { return numCols; }
+   T&         operator()  ( uint32_t r, uint32_t c )       { return cells[size_t(r) * numCols + c]; }
+   const T&   operator()  ( uint32_t r, uint32_t c ) const { return cells[size_t(r) * numCols + c]; }
+   T*         row         ( uint32_t r )       { return cells.data() + size_t(r) * numCols; }
+   const T*   row         ( uint32_t r ) const { return cells.data() + size_t(r) * numCols; }
+   const T*   data        ( ) const { return cells.data(); }
+};
+#include "matrix.cpp"
+#endif
@@ -0,0 +1,240 @@
+//=================================================================
+// CS 271 - Project 6
+// path.cpp
+// Fall 2025
+// This is the implementation file for building and formatting paths
+//=================================================================
+
+#include <algorithm>
+#include <charconv>
+#include <sstream>
+#include <type_traits>
+
+
+//=================================================================
+// tracePath
+// Builds the path to dst from the predecessors left by a search.
+//   Walks back from dst once, finding the edge of each hop in its
+//   source's out-edges, then reverses.
+// Parameters:  g - the graph searched
+//              src - index of the source vertex
+//              dst - index of the destination vertex
+//              weighted - sum edge weights instead of counting hops
+//              ctx - context holding the predecessors
+// Returns:     the path, empty if dst was not reached from src
+//=================================================================
+template <class G>
+Path tracePath ( const G& g, uint32_t src, uint32_t dst, bool weighted, const SearchContext& ctx )
+{
+    Path path;
+    vector<double> hopWeights;
+    for (uint32_t v = dst; v != src; ) {
+        uint32_t u = ctx.getPre(v);
+        if (u == NO_VERTEX)
+            return Path();
+        uint32_t k = 0;
+        typename G::EdgeIterator e = g.edgesBegin(u);
+        while (g.edgeTarget(e) != v) {
+            ++e;
+            k++;
+        }
+        path.vertices.push_back(v);
+        path.edges.push_back(k);
+        hopWeights.push_back(weighted ? g.edgeWeight(e) : 1);
+        v = u;
+    }
+    path.vertices.push_back(src);
+    reverse(path.vertices.begin(), path.vertices.end());
+    reverse(path.edges.begin(), path.edges.end());
+    reverse(hopWeights.begin(), hopWeights.end());
+
+    path.distances.resize(path.vertices.size());
+    path.distances[0] = 0;
+    for (size_t i = 0; i < hopWeights.size(); i++)
+        path.distances[i + 1] = path.distances[i] + hopWeights[i];
+    return path;
+}
+
+//=================================================================
+// pathEdge
+// The edge of hop i of a path
+// Parameters:  g - the graph of the path
+//              path - the path
+//              i - hop number, below path.edges.size()
+// Returns:     iterator to the edge
+//=================================================================
+template <class G>
+typename G::EdgeIterator pathEdge ( const G& g, const Path& path, size_t i )
+{
+    return g.edgesBegin(path.vertices[i]) + path.edges[i];
+}
+
+//=================================================================
+// formatPathText
+// Formats a path one line per vertex, each after the first starting
+//   with the label of the edge leading to it. This is the format
+//   returned by shortestPath.
+// Parameters:  g - the graph of the path
+//              path - the path
+// Returns:     string representation of the path, "" if not found
+//=================================================================
+template <class G>
+string formatPathText ( const G& g, const Path& path )
+{
+    if (!path.found())
+        return "";
+    auto point = [&g](uint32_t v) {
+        tuple<double, double> data = g.vertexData(v);
+        return "(" + to_string(get<0>(data)) + ", " + to_string(get<1>(data)) + ")\n";
+    };
+    string result = "Total distance: " + to_string(path.total()) + "\n" + point(path.vertices[0]);
+    for (size_t i = 0; i < path.edges.size(); i++) {
+        result += g.edgeLabel(pathEdge(g, path, i));
+        result += point(path.vertices[i + 1]);
+    }
+    return result;
+}
+
+//=================================================================
+// jsonNumber
+// Writes a number in the shortest form that reads back exactly
+// Parameters:  out - stream to write to
+//              x - the number; infinities are written as null
+// Returns:     none
+//=================================================================
+inline void jsonNumber ( ostream& out, double x )
+{
+    if (x == SearchContext::INF || x == -SearchContext::INF || x != x) {
+        out << "null";
+        return;
+    }
+    char text[32];
+    out.write(text, to_chars(text, text + sizeof(text), x).ptr - text);
+}
+
+//=================================================================
+// jsonString
+// Writes a string as a quoted JSON string
+// Parameters:  out - stream to write to
+//              s - the string
+// Returns:     none
+//=================================================================
+inline void jsonString ( ostream& out, const string& s )
+{
+    static const char hex[] = "0123456789abcdef";
+    out << '"';
+    for (char c : s) {
+        if (c == '"' || c == '\\')
+            out << '\\' << c;
+        else if (c == '\n')
+            out << "\\n";
+        else if (c == '\t')
+            out << "\\t";
+        else if (c == '\r')
+            out << "\\r";
+        else if (static_cast<unsigned char>(c) < 0x20)
+            out << "\\u00" << hex[c >> 4] << hex[c & 15];
+        else
+            out << c;
+    }
+    out << '"';
+}
+
+//=================================================================
+// jsonKey
+// Writes a vertex key: numbers as JSON numbers, anything else as
+//   the JSON string of its << output
+// Parameters:  out - stream to write to
+//              key - the key
+// Returns:     none
+//=================================================================
+template <class K>
+void jsonKey ( ostream& out, const K& key )
+{
+    if constexpr (is_arithmetic<K>::value) {
+        out << key;
+    } else {
+        ostringstream text;
+        text << key;
+        jsonString(out, text.str());
+    }
+}
+
+//=================================================================
+// formatPathJSON
+// Formats a path as a JSON object:
+//   {"found": true, "distance": 2.5, "vertices": [
+//     {"key": 1, "x": -82.5, "y": 40.1, "distance": 0},
+//     {"key": 2, "x": ..., "y": ..., "distance": 2.5, "edge": 0, "label": "Elm"}]}
+//   where edge and label describe the edge leading to the vertex
+// Parameters:  g - the graph of the path
+//              path - the path
+// Returns:     the JSON text
+//=================================================================
+template <class G>
+string formatPathJSON ( const G& g, const Path& path )
+{
+    ostringstream out;
+    out << "{\"found\": " << (path.found() ? "true" : "false") << ", \"distance\": ";
+    jsonNumber(out, path.total());
+    out << ", \"vertices\": [";
+    for (size_t i = 0; i < path.vertices.size(); i++) {
+        uint32_t v = path.vertices[i];
+        tuple<double, double> data = g.vertexData(v);
+        out << (i > 0 ? ", " : "") << "{\"key\": ";
+        jsonKey(out, g.keyAt(v));
+        out << ", \"x\": ";
+        jsonNumber(out, get<0>(data));
+        out << ", \"y\": ";
+        jsonNumber(out, get<1>(data));
+        out << ", \"distance\": ";
+        jsonNumber(out, path.distances[i]);
+        if (i > 0) {
+            out << ", \"edge\": " << path.edges[i - 1] << ", \"label\": ";
+            jsonString(out, g.edgeLabel(pathEdge(g, path, i - 1)));
+        }
+        out << "}";
+    }
+    out << "]}";
+    return out.str();
+}
+
+//=================================================================
+// formatPathGeoJSON
+// Formats a path as a GeoJSON Feature: a LineString through the
+//   vertex coordinates (longitude, latitude), or a Point for a path
+//   of one vertex, with the total distance and the label of each hop
+//   as properties. A missing path has a null geometry.
+// Parameters:  g - the graph of the path
+//              path - the path
+// Returns:     the GeoJSON text
+//=================================================================
+template <class G>
+string formatPathGeoJSON ( const G& g, const Path& path )
+{
+    ostringstream out;
+    out << "{\"type\": \"Feature\", \"geometry\": ";
+    if (!path.found()) {
+        out << "null";
+    } else {
+        out << "{\"type\": \"" << (path.vertices.size() == 1 ? "Point" : "LineString") << "\", \"coordinates\": ";
+        for (size_t i = 0; i < path.vertices.size(); i++) {
+            tuple<double, double> data = g.vertexData(path.vertices[i]);
+            out << (path.vertices.size() == 1 ? "" : i == 0 ? "[" : ", ") << "[";
+            jsonNumber(out, get<0>(data));
+            out << ", ";
+            jsonNumber(out, get<1>(data));
+            out << "]";
+        }
+        out << (path.vertices.size() == 1 ? "" : "]") << "}";
+    }
+    out << ", \"properties\": {\"distance\": ";
+    jsonNumber(out, path.total());
+    out << ", \"labels\": [";
+    for (size_t i = 0; i < path.edges.size(); i++) {
+        out << (i > 0 ? ", " : "");
+        jsonString(out, g.edgeLabel(pathEdge(g, path, i)));
+    }
+    out << "]}}";
+    return out.str();
+}
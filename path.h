@@ -0,0 +1,51 @@
+//=================================================================
+// CS 271 - Project 6
+// path.h
+// Fall 2025
+// This is the declaration file for the Path struct, the result of a
+// shortest path query, and the writers that format it as text, JSON
+// or GeoJSON
+//=================================================================
+
+#ifndef PATH_H
+#define PATH_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "search_context.h"
+using namespace std;
+
+// A path from a source to a destination. edges[i] is the position of
+// the edge from vertices[i] to vertices[i + 1] among the out-edges of
+// vertices[i] (so edgesBegin(vertices[i]) advanced by edges[i]), and
+// distances[i] is the weight, or the number of hops, from the source
+// to vertices[i]. No vertices means there is no path.
+struct Path
+{
+    vector<uint32_t>  vertices;
+    vector<uint32_t>  edges;
+    vector<double>    distances;
+
+    bool     found     ( ) const { return !vertices.empty(); }
+    double   total     ( ) const { return vertices.empty() ? SearchContext::INF : distances.back(); }
+};
+
+// The writers need, besides the adjacency protocol of graph_search.h,
+//   const K& keyAt     ( uint32_t u ) const;
+//   string   edgeLabel ( EdgeIterator e ) const;   // or a const reference
+// and an EdgeIterator that can be advanced with +.
+template <class G>
+Path     tracePath          ( const G& g, uint32_t src, uint32_t dst, bool weighted, const SearchContext& ctx );
+
+template <class G>
+string   formatPathText     ( const G& g, const Path& path );
+
+template <class G>
+string   formatPathJSON     ( const G& g, const Path& path );
+
+template <class G>
+string   formatPathGeoJSON  ( const G& g, const Path& path );
+
+#include "path.cpp"
+#endif
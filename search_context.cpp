@@ -0,0 +1,84 @@
+//=================================================================
+// CS 271 - Project 6
+// search_context.cpp
+// Fall 2025
+// This is the implementation file for the SearchContext class
+//=================================================================
+
+
+//=================================================================
+// Default constructor
+// Creates a context for an empty graph
+// Parameters:  none
+// Returns:     none
+//=================================================================
+inline SearchContext::SearchContext ( )
+{
+    epoch = 1;
+    source = NO_VERTEX;
+}
+
+//=================================================================
+// reset
+// Starts a new search. Only grows the arrays when the graph has
+//   more vertices than any earlier search; otherwise this just
+//   moves to the next epoch.
+// Parameters:  n - number of vertices in the graph searched
+//              s - source vertex index, if the search has one
+// Returns:     none
+//=================================================================
+inline void SearchContext::reset ( uint32_t n, uint32_t s )
+{
+    epoch++;
+    if (epoch == 0) {
+        // stamps wrapped around, so old stamps could look current again
+        stamp.assign(stamp.size(), 0);
+        epoch = 1;
+    }
+    if (n > stamp.size()) {
+        stamp.resize(n, 0);
+        dist.resize(n);
+        pre.resize(n);
+        color.resize(n);
+        d_time.resize(n);
+        f_time.resize(n);
+        settled.resize((n + 63) / 64);
+        queue.resize(n);
+    }
+    source = s;
+}
+
+//=================================================================
+// touch
+// Gives a vertex its initial state the first time it is written
+//   in the current epoch
+// Parameters:  v - vertex index
+// Returns:     none
+//=================================================================
+inline void SearchContext::touch ( uint32_t v )
+{
+    if (stamp[v] == epoch)
+        return;
+    stamp[v] = epoch;
+    dist[v] = INF;
+    pre[v] = NO_VERTEX;
+    color[v] = 'w';
+    d_time[v] = 0;
+    f_time[v] = 0;
+    settled[v >> 6] &= ~(1ull << (v & 63));
+}
+
+//=================================================================
+// local
+// A context owned by the calling thread, so concurrent queries on
+//   one graph each get their own state without locking. Searches
+//   that need two contexts at once (e.g. bidirectional) use slots
+//   0 and 1.
+// Parameters:  slot - which of the thread's contexts (0 or 1)
+// Returns:     the calling thread's context
+//=================================================================
+inline SearchContext& SearchContext::local ( int slot )
+{
+    thread_local SearchContext ctx[2];
+    return ctx[slot];
+}
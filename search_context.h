@@ -0,0 +1,70 @@
+//=================================================================
+// CS 271 - Project 6
+// search_context.h
+// Fall 2025
+// This is the declaration file for the SearchContext class, the
+// per-query state (distance, predecessor, color, DFS times) of a
+// graph search
+//=================================================================
+
+#ifndef SEARCH_CONTEXT_H
+#define SEARCH_CONTEXT_H
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include "key_index.h"
+#include "indexed_heap.h"
+using namespace std;
+
+// Every array is indexed by dense vertex index. A vertex whose stamp
+// is not the current epoch has never been touched by the current
+// search and reads as white, unreached and without predecessor, so
+// starting a new search is O(1) instead of O(V).
+class SearchContext
+{
+private:
+   vector<uint32_t>  stamp;    // epoch in which each vertex was last written
+   vector<double>    dist;     // distance from source
+   vector<uint32_t>  pre;      // predecessor in search
+   vector<char>      color;    // 'w', 'g', 'b'
+   vector<int>       d_time;   // discovery time in DFS
+   vector<int>       f_time;   // finishing time in DFS
+   vector<uint64_t>  settled;  // one bit per vertex, final distance known
+   vector<uint32_t>  work;     // scratch queue/stack reused across searches
+   IndexedHeap<double> queue;  // priority queue reused across searches
+   uint32_t          epoch;
+   uint32_t          source;   // source of the last single-source search
+
+   void     touch       ( uint32_t v );
+public:
+            SearchContext ( );
+
+   void     reset       ( uint32_t n, uint32_t s = NO_VERTEX );
+   uint32_t size        ( ) const { return stamp.size(); }
+   uint32_t getSource   ( ) const { return source; }
+
+   bool     reached     ( uint32_t v ) const { return stamp[v] == epoch && dist[v] != INF; }
+   double   getDist     ( uint32_t v ) const { return stamp[v] == epoch ? dist[v] : INF; }
+   uint32_t getPre      ( uint32_t v ) const { return stamp[v] == epoch ? pre[v] : NO_VERTEX; }
+   char     getColor    ( uint32_t v ) const { return stamp[v] == epoch ? color[v] : 'w'; }
+   int      getDTime    ( uint32_t v ) const { return stamp[v] == epoch ? d_time[v] : 0; }
+   int      getFTime    ( uint32_t v ) const { return stamp[v] == epoch ? f_time[v] : 0; }
+   bool     isSettled   ( uint32_t v ) const { return stamp[v] == epoch && (settled[v >> 6] >> (v & 63) & 1); }
+
+   void     setDist     ( uint32_t v, double d )   { touch(v); dist[v] = d; }
+   void     setPre      ( uint32_t v, uint32_t u ) { touch(v); pre[v] = u; }
+   void     setColor    ( uint32_t v, char c )     { touch(v); color[v] = c; }
+   void     setDTime    ( uint32_t v, int t )      { touch(v); d_time[v] = t; }
+   void     setFTime    ( uint32_t v, int t )      { touch(v); f_time[v] = t; }
+   void     setSettled  ( uint32_t v )             { touch(v); settled[v >> 6] |= 1ull << (v & 63); }
+
+   vector<uint32_t>&    scratch ( ) { return work; }
+   IndexedHeap<double>& heap    ( ) { return queue; }
+
+   static SearchContext& local ( int slot = 0 );
+
+   static constexpr double INF = numeric_limits<double>::infinity();
+};
+#include "search_context.cpp"
+#endif
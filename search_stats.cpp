@@ -0,0 +1,142 @@
+//=================================================================
+// CS 271 - Project 6
+// search_stats.cpp
+// Fall 2025
+// This is the implementation file for the search counters
+//=================================================================
+
+
+//=================================================================
+// phase
+// Ends the running phase, if any, and starts timing another. Time
+//   adds up if a phase runs more than once.
+// Parameters:  p - the phase starting
+// Returns:     none
+//=================================================================
+inline void QueryStats::phase ( SearchPhase p )
+{
+    finish();
+    running = true;
+    current = p;
+    started = Clock::now();
+}
+
+//=================================================================
+// finish
+// Ends the running phase, if any
+// Parameters:  none
+// Returns:     none
+//=================================================================
+inline void QueryStats::finish ( )
+{
+    if (!running)
+        return;
+    double seconds = chrono::duration<double>(Clock::now() - started).count();
+    if (current == SearchPhase::Initialize)
+        initializeSeconds += seconds;
+    else if (current == SearchPhase::Search)
+        searchSeconds += seconds;
+    else
+        pathSeconds += seconds;
+    running = false;
+}
+
+//=================================================================
+// operator+=
+// Adds the counts and times of another query
+// Parameters:  other - the other query
+// Returns:     this
+//=================================================================
+inline QueryStats& QueryStats::operator+= ( const QueryStats& other )
+{
+    verticesSettled += other.verticesSettled;
+    edgesScanned += other.edgesScanned;
+    relaxations += other.relaxations;
+    heapPushes += other.heapPushes;
+    heapPops += other.heapPops;
+    decreaseKeys += other.decreaseKeys;
+    initializeSeconds += other.initializeSeconds;
+    searchSeconds += other.searchSeconds;
+    pathSeconds += other.pathSeconds;
+    return *this;
+}
+
+//=================================================================
+// StatsRegistry constructor
+// Parameters:  none
+// Returns:     none
+//=================================================================
+inline StatsRegistry::StatsRegistry ( ) : count(0)
+{
+}
+
+//=================================================================
+// record
+// Adds a finished query to the totals
+// Parameters:  stats - the query's counts
+// Returns:     none
+//=================================================================
+inline void StatsRegistry::record ( const QueryStats& stats )
+{
+    lock_guard<mutex> hold(lock);
+    count++;
+    total += stats;
+    if (count == 1 || stats.totalSeconds() > worst.totalSeconds())
+        worst = stats;
+}
+
+//=================================================================
+// reset
+// Forgets every recorded query
+// Parameters:  none
+// Returns:     none
+//=================================================================
+inline void StatsRegistry::reset ( )
+{
+    lock_guard<mutex> hold(lock);
+    count = 0;
+    total = QueryStats();
+    worst = QueryStats();
+}
+
+//=================================================================
+// queries
+// Returns:     number of queries recorded
+//=================================================================
+inline uint64_t StatsRegistry::queries ( ) const
+{
+    lock_guard<mutex> hold(lock);
+    return count;
+}
+
+//=================================================================
+// totals
+// Returns:     the sum of every recorded query
+//=================================================================
+inline QueryStats StatsRegistry::totals ( ) const
+{
+    lock_guard<mutex> hold(lock);
+    return total;
+}
+
+//=================================================================
+// slowest
+// Returns:     the recorded query with the longest total time
+//=================================================================
+inline QueryStats StatsRegistry::slowest ( ) const
+{
+    lock_guard<mutex> hold(lock);
+    return worst;
+}
+
+//=================================================================
+// global
+// The registry shared by the whole process
+// Parameters:  none
+// Returns:     the registry
+//=================================================================
+inline StatsRegistry& StatsRegistry::global ( )
+{
+    static StatsRegistry registry;
+    return registry;
+}
@@ -0,0 +1,92 @@
+//=================================================================
+// CS 271 - Project 6
+// search_stats.h
+// Fall 2025
+// This is the declaration file for the counters a search can keep
+// about the work it did
+//=================================================================
+
+#ifndef SEARCH_STATS_H
+#define SEARCH_STATS_H
+
+#include <cstdint>
+#include <chrono>
+#include <mutex>
+using namespace std;
+
+// The phases of a shortest path query
+enum class SearchPhase { Initialize, Search, Path };
+
+// The search algorithms take a stats policy S with the calls below.
+// NoStats ignores them; its calls are empty and inline, so a search
+// compiled with it is the same code as one with no counting at all.
+struct NoStats
+{
+    void     settled    ( ) { }
+    void     scanned    ( ) { }
+    void     relaxed    ( ) { }
+    void     pushed     ( ) { }
+    void     popped     ( ) { }
+    void     decreased  ( ) { }
+    void     phase      ( SearchPhase ) { }
+    void     finish     ( ) { }
+};
+
+// QueryStats counts the work of one query. Pushes and pops are on the
+// search's queue: the heap in dijkstra, the FIFO in BFS. The heap
+// updates a queued vertex in place (decrease-key), so it never holds
+// stale entries; decreaseKeys counts those updates instead.
+struct QueryStats
+{
+    uint64_t verticesSettled = 0;   // vertices whose distance became final
+    uint64_t edgesScanned    = 0;   // out-edges looked at
+    uint64_t relaxations     = 0;   // edges that improved a distance
+    uint64_t heapPushes      = 0;
+    uint64_t heapPops        = 0;
+    uint64_t decreaseKeys    = 0;
+    double   initializeSeconds = 0; // resetting the search state
+    double   searchSeconds   = 0;   // the search loop
+    double   pathSeconds     = 0;   // tracing and formatting the path
+
+    void     settled    ( ) { verticesSettled++; }
+    void     scanned    ( ) { edgesScanned++; }
+    void     relaxed    ( ) { relaxations++; }
+    void     pushed     ( ) { heapPushes++; }
+    void     popped     ( ) { heapPops++; }
+    void     decreased  ( ) { decreaseKeys++; }
+    void     phase      ( SearchPhase p );
+    void     finish     ( );
+
+    double   totalSeconds ( ) const { return initializeSeconds + searchSeconds + pathSeconds; }
+    QueryStats& operator+= ( const QueryStats& other );
+
+private:
+    typedef chrono::steady_clock Clock;
+    bool              running = false;
+    SearchPhase       current = SearchPhase::Initialize;
+    Clock::time_point started;
+};
+
+// Totals over every query run with stats, for finding the expensive
+// ones in a long-running process. Recording takes a lock, but only
+// queries that asked for stats record.
+class StatsRegistry
+{
+private:
+    mutable mutex lock;
+    uint64_t      count;
+    QueryStats    total;
+    QueryStats    worst;    // the query with the longest total time
+public:
+                StatsRegistry ( );
+
+    void        record      ( const QueryStats& stats );
+    void        reset       ( );
+    uint64_t    queries     ( ) const;
+    QueryStats  totals      ( ) const;
+    QueryStats  slowest     ( ) const;
+
+    static StatsRegistry& global ( );
+};
+#include "search_stats.cpp"
+#endif
@@ -0,0 +1,299 @@
+//=================================================================
+// CS 271 - Project 6
+// shortest_path_tree.cpp
+// Fall 2025
+// This is the implementation file for the ShortestPathTree class
+//=================================================================
+
+#include <stdexcept>
+
+
+//=================================================================
+// Constructor
+// Runs dijkstra from source and keeps the result
+// Parameters:  g - the graph, which must outlive the tree
+//              source - key of the source vertex
+// Returns:     none
+// Throws:      invalid_argument if the source is not found
+//=================================================================
+template <class K, class D>
+ShortestPathTree<K,D>::ShortestPathTree ( Graph<K,D>& g, K source ) : g(&g)
+{
+    s = g.indexOf(source);
+    if (s == NO_VERTEX)
+        throw invalid_argument("Error in ShortestPathTree: Source vertex not found.");
+    rebuild();
+}
+
+//=================================================================
+// rebuild
+// Runs dijkstra from the source again, for after the graph was
+//   changed without going through the tree
+// Parameters:  none
+// Returns:     none
+//=================================================================
+template <class K, class D>
+void ShortestPathTree<K,D>::rebuild ( )
+{
+    n = g->numVertices();
+    dijkstraSearch(*g, s, tree);
+    affected.assign(n, 0);
+}
+
+//=================================================================
+// grow
+// Covers vertices inserted into the graph since the tree was last
+//   touched. They start out unreached.
+// Parameters:  none
+// Returns:     none
+//=================================================================
+template <class K, class D>
+void ShortestPathTree<K,D>::grow ( )
+{
+    uint32_t m = g->numVertices();
+    if (m == n)
+        return;
+    // resetting the context forgets the old entries, so carry them over
+    vector<double> dist(n);
+    vector<uint32_t> pre(n);
+    for (uint32_t v = 0; v < n; v++) {
+        dist[v] = tree.getDist(v);
+        pre[v] = tree.getPre(v);
+    }
+    tree.reset(m, s);
+    for (uint32_t v = 0; v < n; v++) {
+        if (dist[v] != SearchContext::INF) {
+            tree.setDist(v, dist[v]);
+            tree.setPre(v, pre[v]);
+        }
+    }
+    affected.resize(m, 0);
+    n = m;
+}
+
+//=================================================================
+// distance
+// Returns the length of the shortest path from the source
+// Parameters:  d - key of the destination vertex
+// Returns:     the distance, INF if d cannot be reached
+// Throws:      invalid_argument if the vertex is not found
+//=================================================================
+template <class K, class D>
+double ShortestPathTree<K,D>::distance ( K d ) const
+{
+    uint32_t v = g->indexOf(d);
+    if (v == NO_VERTEX)
+        throw invalid_argument("Error in distance: Vertex not found.");
+    return v < n ? tree.getDist(v) : SearchContext::INF;
+}
+
+//=================================================================
+// findPath
+// Reads the shortest path from the source off the tree
+// Parameters:  d - key of the destination vertex
+// Returns:     the path, empty if d cannot be reached
+// Throws:      invalid_argument if the vertex is not found
+//=================================================================
+template <class K, class D>
+Path ShortestPathTree<K,D>::findPath ( K d ) const
+{
+    uint32_t v = g->indexOf(d);
+    if (v == NO_VERTEX)
+        throw invalid_argument("Error in findPath: Vertex not found.");
+    if (v >= n)
+        return Path();
+    return tracePath(*g, s, v, true, tree);
+}
+
+//=================================================================
+// shortestPath
+// Same as above, formatted as Graph::shortestPath formats it
+// Parameters:  d - key of the destination vertex
+// Returns:     string representation of the shortest path
+//=================================================================
+template <class K, class D>
+string ShortestPathTree<K,D>::shortestPath ( K d ) const
+{
+    if (g->indexOf(d) == NO_VERTEX) {
+        return "Either one or both of your input keys don't exist as a vertex.";
+    }
+    return formatPathText(*g, findPath(d));
+}
+
+//=================================================================
+// insertEdge
+// Inserts an edge into the graph, or changes the weight and label of
+//   an existing one, and repairs the tree
+// Parameters:  v1 - key of the first vertex
+//              v2 - key of the second vertex
+//              w  - weight of the edge
+//              label - name of the edge
+// Returns:     number of vertices whose distance was recomputed
+// Throws:      invalid_argument if either vertex is not found or
+//              the weight is negative
+//=================================================================
+template <class K, class D>
+uint32_t ShortestPathTree<K,D>::insertEdge ( K v1, K v2, double w, const string& label )
+{
+    uint32_t u = g->indexOf(v1);
+    uint32_t v = g->indexOf(v2);
+    if (u == NO_VERTEX || v == NO_VERTEX)
+        throw invalid_argument("Error in insertEdge: One or both vertices not found.");
+    if (w < 0)
+        throw invalid_argument("Error in insertEdge: Negative weight.");
+    double old = g->isEdge(v1, v2) ? g->getWeight(v1, v2) : SearchContext::INF;
+    g->insertEdge(v1, v2, w, label);
+    grow();
+
+    if (w < old)
+        return improve(u, v, w);
+    if (w > old)
+        return worsen(u, v);
+    return 0;
+}
+
+//=================================================================
+// updateWeight
+// Changes the weight of an existing edge, keeping its label, and
+//   repairs the tree
+// Parameters:  v1 - key of the first vertex
+//              v2 - key of the second vertex
+//              w  - new weight of the edge
+// Returns:     number of vertices whose distance was recomputed
+// Throws:      invalid_argument if the edge is not found or the
+//              weight is negative
+//=================================================================
+template <class K, class D>
+uint32_t ShortestPathTree<K,D>::updateWeight ( K v1, K v2, double w )
+{
+    uint32_t u = g->indexOf(v1);
+    uint32_t v = g->indexOf(v2);
+    if (u == NO_VERTEX || v == NO_VERTEX || !g->isEdge(v1, v2))
+        throw invalid_argument("Error in updateWeight: Edge not found.");
+    auto e = g->edgesBegin(u);
+    while (g->edgeTarget(e) != v)
+        ++e;
+    string label = g->edgeLabel(e);
+    return insertEdge(v1, v2, w, label);
+}
+
+//=================================================================
+// improve
+// Repairs the tree after edge u -> v was added or made shorter.
+//   Only vertices that get strictly closer are queued, and each is
+//   final when it leaves the heap, as in dijkstra.
+// Parameters:  u - index of the edge's source
+//              v - index of the edge's target
+//              w - new weight of the edge
+// Returns:     number of vertices whose distance went down
+//=================================================================
+template <class K, class D>
+uint32_t ShortestPathTree<K,D>::improve ( uint32_t u, uint32_t v, double w )
+{
+    double dv = tree.getDist(u) + w;
+    if (!(dv < tree.getDist(v)))
+        return 0;
+    tree.setDist(v, dv);
+    tree.setPre(v, u);
+
+    IndexedHeap<double>& q = tree.heap();
+    q.clear();
+    q.push(v, dv);
+    uint32_t count = 0;
+    while (!q.empty()) {
+        uint32_t x = q.pop();
+        double dx = tree.getDist(x);
+        count++;
+        for (auto e = g->edgesBegin(x); e != g->edgesEnd(x); ++e) {
+            uint32_t y = g->edgeTarget(e);
+            double dy = dx + g->edgeWeight(e);
+            if (dy < tree.getDist(y)) {
+                tree.setDist(y, dy);
+                tree.setPre(y, x);
+                q.push(y, dy);
+            }
+        }
+    }
+    return count;
+}
+
+//=================================================================
+// worsen
+// Repairs the tree after edge u -> v was made longer. If the edge is
+//   in the tree, the vertices below v are the only ones whose
+//   distance can change; they are cleared, seeded from in-neighbors
+//   outside that subtree, and settled by a dijkstra that does not
+//   leave the subtree. Vertices with no way back stay unreached.
+// Parameters:  u - index of the edge's source
+//              v - index of the edge's target
+// Returns:     number of vertices in the cleared subtree
+//=================================================================
+template <class K, class D>
+uint32_t ShortestPathTree<K,D>::worsen ( uint32_t u, uint32_t v )
+{
+    if (tree.getPre(v) != u)
+        return 0;
+
+    // collect the subtree under v; a child of x is an out-neighbor
+    // whose predecessor is x
+    vector<uint32_t>& sub = tree.scratch();
+    sub.clear();
+    sub.push_back(v);
+    affected[v] = 1;
+    for (size_t i = 0; i < sub.size(); i++) {
+        uint32_t x = sub[i];
+        for (auto e = g->edgesBegin(x); e != g->edgesEnd(x); ++e) {
+            uint32_t y = g->edgeTarget(e);
+            if (!affected[y] && tree.getPre(y) == x) {
+                affected[y] = 1;
+                sub.push_back(y);
+            }
+        }
+    }
+    for (uint32_t x : sub) {
+        tree.setDist(x, SearchContext::INF);
+        tree.setPre(x, NO_VERTEX);
+    }
+
+    // distances outside the subtree are unchanged, so the best way in
+    // from outside is a safe starting estimate
+    IndexedHeap<double>& q = tree.heap();
+    q.clear();
+    for (uint32_t x : sub) {
+        double best = SearchContext::INF;
+        uint32_t from = NO_VERTEX;
+        for (auto e = g->inEdgesBegin(x); e != g->inEdgesEnd(x); ++e) {
+            uint32_t y = g->inEdgeSource(e);
+            double d = tree.getDist(y) + g->inEdgeWeight(e);
+            if (!affected[y] && d < best) {
+                best = d;
+                from = y;
+            }
+        }
+        if (from != NO_VERTEX) {
+            tree.setDist(x, best);
+            tree.setPre(x, from);
+            q.push(x, best);
+        }
+    }
+
+    while (!q.empty()) {
+        uint32_t x = q.pop();
+        double dx = tree.getDist(x);
+        affected[x] = 0;
+        for (auto e = g->edgesBegin(x); e != g->edgesEnd(x); ++e) {
+            uint32_t y = g->edgeTarget(e);
+            double dy = dx + g->edgeWeight(e);
+            if (affected[y] && dy < tree.getDist(y)) {
+                tree.setDist(y, dy);
+                tree.setPre(y, x);
+                q.push(y, dy);
+            }
+        }
+    }
+
+    uint32_t count = sub.size();
+    for (uint32_t x : sub)
+        affected[x] = 0;
+    return count;
+}
@@ -0,0 +1,60 @@
+//=================================================================
+// CS 271 - Project 6
+// shortest_path_tree.h
+// Fall 2025
+// This is the declaration file for the ShortestPathTree class, the
+// shortest paths from one source kept up to date as edges change
+//=================================================================
+
+#ifndef SHORTEST_PATH_TREE_H
+#define SHORTEST_PATH_TREE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "graph.h"
+#include "search_context.h"
+#include "path.h"
+using namespace std;
+
+// Edge changes go through the tree, which passes them on to the graph
+// and repairs its distances and predecessors in the manner of
+// Ramalingam and Reps instead of running dijkstra again:
+//   a new edge or a lower weight can only shorten paths, so a
+//   dijkstra seeded at the edge's target visits just the vertices
+//   that get closer;
+//   a higher weight on a tree edge u -> v can only lengthen paths
+//   through v, so just v's subtree is cleared, each of its vertices
+//   is seeded from its best in-neighbor outside the subtree, and a
+//   dijkstra confined to the subtree finishes the job.
+// A higher weight on an edge outside the tree changes nothing.
+// Changes made to the graph directly, not through the tree, leave the
+// tree stale until rebuild(). Weights must not be negative.
+template <class K, class D>
+class ShortestPathTree
+{
+private:
+   Graph<K,D>*        g;
+   uint32_t           s;         // source vertex index
+   uint32_t           n;         // vertices covered by tree
+   SearchContext      tree;      // distances and predecessors from s
+   vector<char>       affected;  // nonzero for subtree vertices during a repair
+
+   void     grow           ( );
+   uint32_t improve        ( uint32_t u, uint32_t v, double w );
+   uint32_t worsen         ( uint32_t u, uint32_t v );
+public:
+            ShortestPathTree ( Graph<K,D>& g, K source );
+
+   K        source         ( ) const { return g->keyAt(s); }
+   double   distance       ( K d ) const;
+   Path     findPath       ( K d ) const;
+   string   shortestPath   ( K d ) const;
+   const SearchContext& context ( ) const { return tree; }
+
+   uint32_t insertEdge     ( K v1, K v2, double w, const string& label );
+   uint32_t updateWeight   ( K v1, K v2, double w );
+   void     rebuild        ( );
+};
+#include "shortest_path_tree.cpp"
+#endif
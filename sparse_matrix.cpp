@@ -0,0 +1,26 @@
+//=================================================================
+// CS 271 - Project 6
+// sparse_matrix.cpp
+// Fall 2025
+// This is the implementation file for the sparse matrix conversions
+//=================================================================
+
+
+//=================================================================
+// toCOO
+// Lists the entries of a CSR matrix as coordinates, row by row
+// Parameters:  csr - the matrix
+// Returns:     the same matrix in coordinate form
+//=================================================================
+inline CooMatrix toCOO ( const CsrMatrix& csr )
+{
+    CooMatrix coo;
+    coo.numRows = csr.numRows;
+    coo.numCols = csr.numCols;
+    coo.rowIndex.reserve(csr.columns.size());
+    for (uint32_t r = 0; r < csr.numRows; r++)
+        coo.rowIndex.insert(coo.rowIndex.end(), csr.offsets[r + 1] - csr.offsets[r], r);
+    coo.colIndex = csr.columns;
+    coo.values = csr.values;
+    return coo;
+}
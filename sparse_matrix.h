@@ -0,0 +1,41 @@
+//=================================================================
+// CS 271 - Project 6
+// sparse_matrix.h
+// Fall 2025
+// This is the declaration file for the CsrMatrix and CooMatrix
+// structs, sparse matrices in compressed sparse row and coordinate
+// form
+//=================================================================
+
+#ifndef SPARSE_MATRIX_H
+#define SPARSE_MATRIX_H
+
+#include <vector>
+#include <cstdint>
+using namespace std;
+
+// The entries of row r are columns[offsets[r] .. offsets[r + 1]) with
+// the parallel values, in increasing column order.
+struct CsrMatrix
+{
+    uint32_t          numRows = 0;
+    uint32_t          numCols = 0;
+    vector<uint32_t>  offsets;   // numRows + 1 entries
+    vector<uint32_t>  columns;
+    vector<double>    values;
+};
+
+// Entry i is (rowIndex[i], colIndex[i]) = values[i].
+struct CooMatrix
+{
+    uint32_t          numRows = 0;
+    uint32_t          numCols = 0;
+    vector<uint32_t>  rowIndex;
+    vector<uint32_t>  colIndex;
+    vector<double>    values;
+};
+
+CooMatrix toCOO ( const CsrMatrix& csr );
+
+#include "sparse_matrix.cpp"
+#endif
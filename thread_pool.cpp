@@ -0,0 +1,138 @@
+//=================================================================
+// CS 271 - Project 6
+// thread_pool.cpp
+// Fall 2025
+// This is the implementation file for the ThreadPool class
+//=================================================================
+
+#include <stdexcept>
+
+
+//=================================================================
+// Constructor
+// Starts the worker threads
+// Parameters:  threads - total threads working on a loop, including
+//              the caller; 0 is treated as 1
+// Returns:     none
+//=================================================================
+inline ThreadPool::ThreadPool ( unsigned threads )
+    : body(nullptr), end(0), grain(1), next(0), busy(0), generation(0), stopping(false)
+{
+    for (unsigned id = 1; id < threads; id++)
+        workers.emplace_back(&ThreadPool::workerLoop, this, id);
+}
+
+//=================================================================
+// Destructor
+// Stops and joins the worker threads
+// Parameters:  none
+// Returns:     none
+//=================================================================
+inline ThreadPool::~ThreadPool ( )
+{
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (thread& t : workers)
+        t.join();
+}
+
+//=================================================================
+// parallelFor
+// Calls f(begin, end, worker) on disjoint chunks covering [0, n).
+//   worker is in [0, size()), so f can keep per-worker results
+//   without locking.
+// Parameters:  n - number of loop iterations
+//              f - loop body for one chunk
+//              chunk - iterations per chunk, for loops of few but
+//                      costly iterations; 0 picks a size from n and
+//                      runs loops under MIN_PARALLEL inline
+// Returns:     none
+// Throws:      the first exception thrown by f, once no chunk is
+//              running; logic_error if called from inside f
+//=================================================================
+inline void ThreadPool::parallelFor ( size_t n, const Body& f, size_t chunk )
+{
+    if (running == this)
+        throw logic_error("Error in parallelFor: Called from inside a loop of the same pool.");
+    if (n == 0)
+        return;
+    if (workers.empty() || (chunk == 0 ? n < MIN_PARALLEL : n <= chunk)) {
+        InBody inside(this);
+        f(0, n, 0);
+        return;
+    }
+
+    lock_guard<mutex> serial(calls);
+    {
+        lock_guard<mutex> guard(lock);
+        body = &f;
+        end = n;
+        grain = chunk > 0 ? chunk : max<size_t>(1, n / (size() * 8));
+        next = 0;
+        busy = workers.size();
+        generation++;
+    }
+    wake.notify_all();
+    runChunks(0);
+
+    unique_lock<mutex> guard(lock);
+    finished.wait(guard, [this] { return busy == 0; });
+    body = nullptr;
+    exception_ptr thrown = error;
+    error = nullptr;
+    guard.unlock();
+    if (thrown)
+        rethrow_exception(thrown);
+}
+
+//=================================================================
+// runChunks
+// Claims and runs chunks of the current loop until none are left.
+//   An exception from the body is kept for parallelFor to rethrow,
+//   and the remaining chunks are abandoned.
+// Parameters:  id - worker number passed to the loop body
+// Returns:     none
+//=================================================================
+inline void ThreadPool::runChunks ( unsigned id )
+{
+    InBody inside(this);
+    try {
+        for (size_t begin = next.fetch_add(grain); begin < end; begin = next.fetch_add(grain))
+            (*body)(begin, min(begin + grain, end), id);
+    }
+    catch (...) {
+        next = end;
+        lock_guard<mutex> guard(lock);
+        if (!error)
+            error = current_exception();
+    }
+}
+
+//=================================================================
+// workerLoop
+// Body of each worker thread: waits for a loop, helps run it
+// Parameters:  id - worker number, 1 .. size()-1
+// Returns:     none
+//=================================================================
+inline void ThreadPool::workerLoop ( unsigned id )
+{
+    uint64_t seen = 0;
+    while (true) {
+        {
+            unique_lock<mutex> guard(lock);
+            wake.wait(guard, [&] { return stopping || generation != seen; });
+            if (stopping)
+                return;
+            seen = generation;
+        }
+        runChunks(id);
+        {
+            lock_guard<mutex> guard(lock);
+            if (--busy == 0)
+                finished.notify_one();
+        }
+    }
+}
@@ -0,0 +1,71 @@
+//=================================================================
+// CS 271 - Project 6
+// thread_pool.h
+// Fall 2025
+// This is the declaration file for the ThreadPool class, a fixed
+// set of worker threads that run parallel loops
+//=================================================================
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+#include <cstdint>
+using namespace std;
+
+// parallelFor splits [0, n) into chunks that the workers claim one at
+// a time; the calling thread works too and returns once every chunk
+// is done. A pool of size 1 has no extra threads and runs loops
+// inline. Calls from different threads are serialized.
+// If the body throws, no further chunks are started, the call waits
+// for the chunks already running and then rethrows the first
+// exception. A body must not call parallelFor on its own pool (it
+// would wait on itself); such a call throws logic_error instead.
+class ThreadPool
+{
+private:
+   typedef function<void(size_t, size_t, unsigned)> Body;
+
+   static constexpr size_t MIN_PARALLEL = 1024;   // smaller loops run inline
+
+   vector<thread>      workers;
+   mutex               lock;       // guards everything below
+   condition_variable  wake;       // a new loop was posted, or stopping
+   condition_variable  finished;   // the last worker left the loop
+   mutex               calls;      // one parallelFor at a time
+   const Body*         body;
+   size_t              end;
+   size_t              grain;
+   atomic<size_t>      next;       // start of the next unclaimed chunk
+   unsigned            busy;       // workers still inside the loop
+   uint64_t            generation; // counts posted loops
+   bool                stopping;
+   exception_ptr       error;      // first exception thrown by body
+
+   static inline thread_local const ThreadPool* running = nullptr; // pool whose body this thread is in
+
+   // marks the current thread as inside a body of pool for its lifetime
+   struct InBody
+   {
+       const ThreadPool* outer;
+       explicit InBody ( const ThreadPool* pool ) : outer(running) { running = pool; }
+               ~InBody ( ) { running = outer; }
+   };
+
+   void     workerLoop  ( unsigned id );
+   void     runChunks   ( unsigned id );
+public:
+   explicit ThreadPool  ( unsigned threads = thread::hardware_concurrency() );
+           ~ThreadPool  ( );
+
+   unsigned size        ( ) const { return workers.size() + 1; }
+   void     parallelFor ( size_t n, const Body& f, size_t chunk = 0 );
+};
+#include "thread_pool.cpp"
+#endif
@@ -0,0 +1,194 @@
+//=================================================================
+// CS 271 - Project 6
+// vertex_order.cpp
+// Fall 2025
+// This is the implementation file for the vertex orderings
+//=================================================================
+
+#include <algorithm>
+#include <numeric>
+
+
+//=================================================================
+// vertexOrder
+// Computes one of the orderings
+// Parameters:  g - the graph
+//              order - which ordering
+// Returns:     old index of the vertex at each new index
+//=================================================================
+template <class G>
+vector<uint32_t> vertexOrder ( const G& g, VertexOrder order )
+{
+    switch (order) {
+    case VertexOrder::Hilbert:
+        return hilbertOrder(g);
+    case VertexOrder::BreadthFirst:
+        return breadthFirstOrder(g);
+    case VertexOrder::CuthillMcKee:
+        return cuthillMcKeeOrder(g);
+    default:
+        vector<uint32_t> same(g.numVertices());
+        iota(same.begin(), same.end(), 0);
+        return same;
+    }
+}
+
+//=================================================================
+// hilbertIndex
+// Distance along a Hilbert curve filling a 65536 x 65536 grid
+// Parameters:  x, y - cell, each below 65536
+// Returns:     position of the cell on the curve
+//=================================================================
+inline uint32_t hilbertIndex ( uint32_t x, uint32_t y )
+{
+    const uint32_t N = 1u << 16;
+    uint32_t d = 0;
+    for (uint32_t s = N / 2; s > 0; s /= 2) {
+        uint32_t rx = (x & s) > 0;
+        uint32_t ry = (y & s) > 0;
+        d += s * s * ((3 * rx) ^ ry);
+        // rotate the quadrant so the curve inside it starts at its corner
+        if (ry == 0) {
+            if (rx == 1) {
+                x = N - 1 - x;
+                y = N - 1 - y;
+            }
+            swap(x, y);
+        }
+    }
+    return d;
+}
+
+//=================================================================
+// hilbertOrder
+// Orders vertices along a Hilbert curve over the bounding box of
+//   their (longitude, latitude), ties by old index
+// Parameters:  g - the graph
+// Returns:     old index of the vertex at each new index
+//=================================================================
+template <class G>
+vector<uint32_t> hilbertOrder ( const G& g )
+{
+    uint32_t n = g.numVertices();
+    double minX = 0, maxX = 0, minY = 0, maxY = 0;
+    for (uint32_t u = 0; u < n; u++) {
+        tuple<double, double> p = g.vertexData(u);
+        if (u == 0 || get<0>(p) < minX) minX = get<0>(p);
+        if (u == 0 || get<0>(p) > maxX) maxX = get<0>(p);
+        if (u == 0 || get<1>(p) < minY) minY = get<1>(p);
+        if (u == 0 || get<1>(p) > maxY) maxY = get<1>(p);
+    }
+    double scaleX = maxX > minX ? 65535 / (maxX - minX) : 0;
+    double scaleY = maxY > minY ? 65535 / (maxY - minY) : 0;
+
+    vector<pair<uint32_t, uint32_t>> keyed(n);
+    for (uint32_t u = 0; u < n; u++) {
+        tuple<double, double> p = g.vertexData(u);
+        uint32_t x = (get<0>(p) - minX) * scaleX;
+        uint32_t y = (get<1>(p) - minY) * scaleY;
+        keyed[u] = make_pair(hilbertIndex(x, y), u);
+    }
+    sort(keyed.begin(), keyed.end());
+    vector<uint32_t> order(n);
+    for (uint32_t i = 0; i < n; i++)
+        order[i] = keyed[i].second;
+    return order;
+}
+
+//=================================================================
+// breadthFirstOrder
+// Orders vertices by breadth-first search over edges in both
+//   directions, starting each new component at its lowest index
+// Parameters:  g - the graph
+// Returns:     old index of the vertex at each new index
+//=================================================================
+template <class G>
+vector<uint32_t> breadthFirstOrder ( const G& g )
+{
+    uint32_t n = g.numVertices();
+    vector<char> seen(n, 0);
+    vector<uint32_t> order;
+    order.reserve(n);
+    for (uint32_t root = 0; root < n; root++) {
+        if (seen[root])
+            continue;
+        seen[root] = 1;
+        order.push_back(root);
+        // order doubles as the queue: everything after head is waiting
+        for (size_t head = order.size() - 1; head < order.size(); head++) {
+            uint32_t u = order[head];
+            for (auto e = g.edgesBegin(u); e != g.edgesEnd(u); ++e) {
+                uint32_t v = g.edgeTarget(e);
+                if (!seen[v]) {
+                    seen[v] = 1;
+                    order.push_back(v);
+                }
+            }
+            for (auto e = g.inEdgesBegin(u); e != g.inEdgesEnd(u); ++e) {
+                uint32_t v = g.inEdgeSource(e);
+                if (!seen[v]) {
+                    seen[v] = 1;
+                    order.push_back(v);
+                }
+            }
+        }
+    }
+    return order;
+}
+
+//=================================================================
+// cuthillMcKeeOrder
+// Reverse Cuthill-McKee: breadth-first search over edges in both
+//   directions where each component starts at a vertex of least
+//   degree and neighbors are visited by increasing degree, then the
+//   whole order is reversed
+// Parameters:  g - the graph
+// Returns:     old index of the vertex at each new index
+//=================================================================
+template <class G>
+vector<uint32_t> cuthillMcKeeOrder ( const G& g )
+{
+    uint32_t n = g.numVertices();
+    vector<uint32_t> degree(n, 0);
+    for (uint32_t u = 0; u < n; u++)
+        degree[u] = (g.edgesEnd(u) - g.edgesBegin(u)) + (g.inEdgesEnd(u) - g.inEdgesBegin(u));
+    auto byDegree = [&degree](uint32_t a, uint32_t b) {
+        return degree[a] < degree[b] || (degree[a] == degree[b] && a < b);
+    };
+    vector<uint32_t> roots(n);
+    iota(roots.begin(), roots.end(), 0);
+    sort(roots.begin(), roots.end(), byDegree);
+
+    vector<char> seen(n, 0);
+    vector<uint32_t> order;
+    vector<uint32_t> next;
+    order.reserve(n);
+    for (uint32_t root : roots) {
+        if (seen[root])
+            continue;
+        seen[root] = 1;
+        order.push_back(root);
+        for (size_t head = order.size() - 1; head < order.size(); head++) {
+            uint32_t u = order[head];
+            next.clear();
+            for (auto e = g.edgesBegin(u); e != g.edgesEnd(u); ++e) {
+                uint32_t v = g.edgeTarget(e);
+                if (!seen[v]) {
+                    seen[v] = 1;
+                    next.push_back(v);
+                }
+            }
+            for (auto e = g.inEdgesBegin(u); e != g.inEdgesEnd(u); ++e) {
+                uint32_t v = g.inEdgeSource(e);
+                if (!seen[v]) {
+                    seen[v] = 1;
+                    next.push_back(v);
+                }
+            }
+            sort(next.begin(), next.end(), byDegree);
+            order.insert(order.end(), next.begin(), next.end());
+        }
+    }
+    reverse(order.begin(), order.end());
+    return order;
+}
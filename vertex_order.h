@@ -0,0 +1,42 @@
+//=================================================================
+// CS 271 - Project 6
+// vertex_order.h
+// Fall 2025
+// This is the declaration file for the vertex orderings used to
+// lay out a CompactGraph for cache locality
+//=================================================================
+
+#ifndef VERTEX_ORDER_H
+#define VERTEX_ORDER_H
+
+#include <vector>
+#include <cstdint>
+#include <tuple>
+using namespace std;
+
+// How CompactGraph numbers its vertices. Insertion keeps the graph's
+// own indices. The others renumber so that vertices near each other
+// in the graph sit near each other in memory, and a search touches
+// fewer cache lines per edge:
+//   Hilbert      - position along a Hilbert curve over the coordinates
+//   BreadthFirst - breadth-first order, ignoring edge direction
+//   CuthillMcKee - reverse Cuthill-McKee, a breadth-first order that
+//                  visits low-degree vertices first, for a narrow band
+enum class VertexOrder { Insertion, Hilbert, BreadthFirst, CuthillMcKee };
+
+// Each ordering works on a graph with the adjacency access described
+// in graph_search.h (out- and in-edges, and vertexData for Hilbert)
+// and returns the old index of every vertex in its new position.
+
+template <class G>
+vector<uint32_t> vertexOrder       ( const G& g, VertexOrder order );
+template <class G>
+vector<uint32_t> hilbertOrder      ( const G& g );
+template <class G>
+vector<uint32_t> breadthFirstOrder ( const G& g );
+template <class G>
+vector<uint32_t> cuthillMcKeeOrder ( const G& g );
+uint32_t         hilbertIndex      ( uint32_t x, uint32_t y );
+
+#include "vertex_order.cpp"
+#endif